@@ -111,6 +111,7 @@ HEADERS += \
         ../../Source/MediaInfo/File_Dummy.h \
         ../../Source/MediaInfo/File_Other.h \
         ../../Source/MediaInfo/File_Unknown.h \
+        ../../Source/MediaInfo/Condition.h \
         ../../Source/MediaInfo/HashWrapper.h \
         ../../Source/MediaInfo/Image/File_ArriRaw.h \
         ../../Source/MediaInfo/Image/File_Bmp.h \
@@ -330,6 +331,7 @@ SOURCES += \
         ../../Source/MediaInfo/File_Dummy.cpp \
         ../../Source/MediaInfo/File_Other.cpp \
         ../../Source/MediaInfo/File_Unknown.cpp \
+        ../../Source/MediaInfo/Condition.cpp \
         ../../Source/MediaInfo/HashWrapper.cpp \
         ../../Source/MediaInfo/Image/File_ArriRaw.cpp \
         ../../Source/MediaInfo/Image/File_Bmp.cpp \
@@ -380,9 +380,13 @@ bool File_Aac::Synchronize_ADTS()
     //Synchronizing
     while (Buffer_Offset+6<=Buffer_Size)
     {
-         while (Buffer_Offset+6<=Buffer_Size && (Buffer[Buffer_Offset  ]!=0xFF
-                                              || (Buffer[Buffer_Offset+1]&0xF6)!=0xF0))
+        for (;;)
+        {
+            Synchronize_Byte(0xFF, 0, 6);
+            if (Buffer_Offset+6>Buffer_Size || (Buffer[Buffer_Offset+1]&0xF6)==0xF0)
+                break;
             Buffer_Offset++;
+        }
 
         if (Buffer_Offset+6<=Buffer_Size)//Testing if size is coherant
         {
@@ -4703,13 +4703,9 @@ bool File_Ac3::CRC_Compute(size_t Size)
     if (IgnoreCrc && !Status[IsAccepted]) //Else there are some wrong synchronizations
     {
         MediaInfo_Internal MI;
-        Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-        Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-        MI.Option(__T("ParseSpeed"), __T("0"));
-        MI.Option(__T("Demux"), Ztring());
+        MI.Option(__T("File_ParseSpeed"), __T("0"));
+        MI.Option(__T("File_Demux"), Ztring());
         size_t MiOpenResult=MI.Open(File_Name);
-        MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-        MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
         if (MiOpenResult)
         {
             Ztring Format=MI.Get(Stream_General, 0, General_Format);
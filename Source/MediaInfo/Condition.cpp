@@ -0,0 +1,118 @@
+/*  Copyright (c) MediaArea.net SARL. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license that can
+ *  be found in the License.html file in the root of the source tree.
+ */
+
+//---------------------------------------------------------------------------
+// Pre-compilation
+#include "MediaInfo/PreComp.h"
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+#include "MediaInfo/Setup.h"
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+#include "MediaInfo/Condition.h"
+#ifdef WINDOWS
+    #undef __TEXT
+    #if __cplusplus >= 201703L || _MSVC_LANG >= 201703L
+        namespace WindowsNamespace
+        {
+    #endif
+    #include "windows.h"
+    #if __cplusplus >= 201703L || _MSVC_LANG >= 201703L
+        }
+        using namespace WindowsNamespace;
+    #endif
+#else //WINDOWS
+    #include <pthread.h>
+#endif //WINDOWS
+//---------------------------------------------------------------------------
+
+namespace MediaInfoLib
+{
+
+//***************************************************************************
+// Platform specific
+//***************************************************************************
+
+#ifndef WINDOWS
+//---------------------------------------------------------------------------
+struct condition_posix
+{
+    pthread_mutex_t Mutex;
+    pthread_cond_t  Cond;
+    bool            IsSignaled; //Auto-reset, same behavior as a Windows event
+};
+#endif //WINDOWS
+
+//***************************************************************************
+// Constructor/Destructor
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+Condition::Condition()
+{
+    #ifdef WINDOWS
+        Handle=(void*)CreateEvent(NULL, FALSE, FALSE, NULL);
+    #else //WINDOWS
+        condition_posix* C=new condition_posix;
+        pthread_mutex_init(&C->Mutex, NULL);
+        pthread_cond_init(&C->Cond, NULL);
+        C->IsSignaled=false;
+        Handle=(void*)C;
+    #endif //WINDOWS
+}
+
+//---------------------------------------------------------------------------
+Condition::~Condition()
+{
+    #ifdef WINDOWS
+        CloseHandle((HANDLE)Handle);
+    #else //WINDOWS
+        condition_posix* C=(condition_posix*)Handle;
+        pthread_cond_destroy(&C->Cond);
+        pthread_mutex_destroy(&C->Mutex);
+        delete C;
+    #endif //WINDOWS
+}
+
+//***************************************************************************
+// Actions
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+void Condition::Signal()
+{
+    #ifdef WINDOWS
+        SetEvent((HANDLE)Handle);
+    #else //WINDOWS
+        condition_posix* C=(condition_posix*)Handle;
+        pthread_mutex_lock(&C->Mutex);
+        C->IsSignaled=true;
+        pthread_cond_signal(&C->Cond);
+        pthread_mutex_unlock(&C->Mutex);
+    #endif //WINDOWS
+}
+
+//---------------------------------------------------------------------------
+void Condition::Wait()
+{
+    #ifdef WINDOWS
+        WaitForSingleObject((HANDLE)Handle, INFINITE);
+    #else //WINDOWS
+        condition_posix* C=(condition_posix*)Handle;
+        pthread_mutex_lock(&C->Mutex);
+        while (!C->IsSignaled)
+            pthread_cond_wait(&C->Cond, &C->Mutex);
+        C->IsSignaled=false; //Signal is consumed by the waiter
+        pthread_mutex_unlock(&C->Mutex);
+    #endif //WINDOWS
+}
+
+} //NameSpace
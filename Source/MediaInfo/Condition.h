@@ -0,0 +1,44 @@
+/*  Copyright (c) MediaArea.net SARL. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license that can
+ *  be found in the License.html file in the root of the source tree.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef MediaInfo_ConditionH
+#define MediaInfo_ConditionH
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+namespace MediaInfoLib
+{
+
+//***************************************************************************
+/// @brief Auto-reset event
+/// A signal wakes up one waiter, or is kept for the next call to Wait() if
+/// there is no waiter. Waiters must check again their state after Wait(),
+/// and signal again if other waiters may also have something to do
+//***************************************************************************
+
+class Condition
+{
+public:
+    //Constructor/Destructor
+    Condition();
+    ~Condition();
+
+    //Actions
+    void Signal();
+    void Wait();
+
+private:
+    void* Handle; //Platform specific, not in the header so windows.h is not included everywhere
+
+    //Not copyable
+    Condition(const Condition&);
+    Condition& operator=(const Condition&);
+};
+
+} //NameSpace
+
+#endif
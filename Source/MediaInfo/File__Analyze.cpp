@@ -177,11 +177,25 @@ File__Analyze::File__Analyze ()
         Config_Trace_Layers=MediaInfoLib::Config.Trace_Layers_Get();
         Config_Trace_Format=MediaInfoLib::Config.Trace_Format_Get();
         Trace_DoNotSave=false;
+        Trace_Stream=NULL;
+        Trace_Memory=0;
+        Element_Pool=new element_details::Element_Node_Pool;
         Trace_Layers.set();
         Trace_Layers_Update();
     #endif //MEDIAINFO_TRACE
     Config_Demux=MediaInfoLib::Config.Demux_Get();
+    #if MEDIAINFO_DEMUX
+        Config_Demux_OriginalContent=true;
+    #endif //MEDIAINFO_DEMUX
     Config_LineSeparator=MediaInfoLib::Config.LineSeparator_Get();
+    Config_TagSeparator=MediaInfoLib::Config.TagSeparator_Get();
+    Config_CarriageReturnReplace=MediaInfoLib::Config.CarriageReturnReplace_Get();
+    Config_Legacy=MediaInfoLib::Config.Legacy_Get();
+    for (size_t StreamKind=0; StreamKind<Stream_Max; StreamKind++)
+    {
+        Config_Info[StreamKind]=NULL;
+        Config_Info_Index[StreamKind]=NULL;
+    }
     IsSub=false;
     StreamSource=IsContainer;
 
@@ -250,6 +264,7 @@ File__Analyze::File__Analyze ()
     #endif //MEDIAINFO_SEEK
     Buffer=NULL;
     Buffer_Temp=NULL;
+    Buffer_Temp_Begin=0;
     Buffer_Size=0;
     Buffer_Temp_Size=0;
     Buffer_Temp_Size_Max=0;
@@ -352,6 +367,8 @@ File__Analyze::File__Analyze ()
 File__Analyze::~File__Analyze ()
 {
     //Buffer
+    if (Buffer_Temp)
+        Config->File_Memory_Release(Buffer_Temp_Size_Max);
     delete[] Buffer_Temp; //Buffer_Temp=NULL;
     delete[] OriginalBuffer;
 
@@ -375,6 +392,14 @@ File__Analyze::~File__Analyze ()
         if (!IsSub)
             delete IbiStream; //IbiStream=NULL;
     #endif //MEDIAINFO_IBIUSAGE
+
+    //Trace
+    #if MEDIAINFO_TRACE
+        if (Trace_Stream)
+            Trace_Stream_Flush(true); //Stream is owned by MediaInfo_Internal
+        Config->File_Memory_Release(Trace_Memory);
+        Element_Pool->Release(); //Deleted with the last node
+    #endif //MEDIAINFO_TRACE
 }
 
 //***************************************************************************
@@ -409,6 +434,11 @@ void File__Analyze::Open_Buffer_Init (int64u File_Size_)
     if (MediaInfoLib::Config.FormatDetection_MaximumOffset_Get())
         Buffer_TotalBytes_FirstSynched_Max=MediaInfoLib::Config.FormatDetection_MaximumOffset_Get();
     Config->File_ParseSpeed_Set(MediaInfoLib::Config.ParseSpeed_Get(), true);
+    Config->File_Demux_Set(MediaInfoLib::Config.Demux_Get(), true);
+    Config_Demux=Config->File_Demux_Get();
+    #if MEDIAINFO_DEMUX
+        Config_Demux_OriginalContent=Config->Demux_OriginalContent_Get();
+    #endif //MEDIAINFO_DEMUX
     EOF_AlreadyDetected=(Config->ParseSpeed>=1.0)?true:false;
     if (Config->File_IsSub_Get())
         IsSub=true;
@@ -468,6 +498,13 @@ void File__Analyze::Open_Buffer_Init (File__Analyze* Sub, int64u File_Size_)
     //Parsing
     #if MEDIAINFO_TRACE
         Sub->Init(Config, Details);
+        if (Sub->Element_Pool!=Element_Pool)
+        {
+            //Nodes of the sub-parser move to this parser tree
+            Sub->Element_Pool->Release();
+            Sub->Element_Pool=Element_Pool;
+            Element_Pool->AddRef();
+        }
     #else //MEDIAINFO_TRACE
         Sub->Init(Config);
     #endif //MEDIAINFO_TRACE
@@ -540,7 +577,7 @@ void File__Analyze::Trace_Details_Handling(File__Analyze* Sub)
                     Sub->Element_End0();
 
             //Add Sub to this node
-            Element[Element_Level].TraceNode.Add_Child(&Sub->Element[Sub->Element_Level].TraceNode);
+            Element[Element_Level].TraceNode.Add_Child(&Sub->Element[Sub->Element_Level].TraceNode, Element_Pool);
             Sub->Element[Sub->Element_Level].TraceNode.Init();
         }
         else
@@ -575,7 +612,7 @@ void File__Analyze::Open_Buffer_Continue (const int8u* ToAdd, size_t ToAdd_Size)
         {
             if (!IsSub && !Buffer_Temp_Size && File_Offset==Config->File_Current_Offset && Config->File_Hash_Get().to_ulong())
             {
-                delete Hash; Hash=new HashWrapper(Config->File_Hash_Get().to_ulong());
+                delete Hash; Hash=new HashWrapper(Config->File_Hash_Get().to_ulong(), Config->File_Hash_Threaded_Get());
             }
             if (Hash)
             {
@@ -666,26 +703,46 @@ void File__Analyze::Open_Buffer_Continue (const int8u* ToAdd, size_t ToAdd_Size)
     if (Buffer_Temp_Size) //There is buffered data from before
     {
         //Allocating new buffer if needed
-        if (Buffer_Temp_Size+ToAdd_Size>Buffer_Temp_Size_Max)
+        if (Buffer_Temp_Begin+Buffer_Temp_Size+ToAdd_Size>Buffer_Temp_Size_Max)
         {
-            int8u* Old=Buffer_Temp;
-            size_t Buffer_Temp_Size_Max_ToAdd=ToAdd_Size>32768?ToAdd_Size:32768;
-            if (Buffer_Temp_Size_Max_ToAdd<Buffer_Temp_Size_Max) Buffer_Temp_Size_Max_ToAdd=Buffer_Temp_Size_Max;
-            Buffer_Temp_Size_Max+=Buffer_Temp_Size_Max_ToAdd;
-            Buffer_Temp=new int8u[Buffer_Temp_Size_Max];
-            memcpy_Unaligned_Unaligned(Buffer_Temp, Old, Buffer_Temp_Size);
-            delete[] Old; //Old=NULL;
+            if (Buffer_Temp_Size+ToAdd_Size<=Buffer_Temp_Size_Max && Buffer_Temp_Begin>=Buffer_Temp_Size)
+            {
+                //Reusing the consumed bytes, there are more of them than moved bytes
+                memcpy_Unaligned_Unaligned(Buffer_Temp, Buffer_Temp+Buffer_Temp_Begin, Buffer_Temp_Size);
+            }
+            else
+            {
+                int8u* Old=Buffer_Temp;
+                size_t Buffer_Temp_Size_Max_ToAdd=ToAdd_Size>32768?ToAdd_Size:32768;
+                if (Buffer_Temp_Size_Max_ToAdd<Buffer_Temp_Size_Max) Buffer_Temp_Size_Max_ToAdd=Buffer_Temp_Size_Max;
+                if (!Config->File_Memory_Reserve(Buffer_Temp_Size_Max_ToAdd))
+                {
+                    if (Status[IsFilled])
+                    {
+                        ForceFinish(); //Memory budget exceeded, keeping what is already found
+                        return;
+                    }
+                    Config->File_Memory_Add(Buffer_Temp_Size_Max_ToAdd); //Still needed for detecting the format
+                }
+                Buffer_Temp_Size_Max+=Buffer_Temp_Size_Max_ToAdd;
+                Buffer_Temp=new int8u[Buffer_Temp_Size_Max];
+                memcpy_Unaligned_Unaligned(Buffer_Temp, Old+Buffer_Temp_Begin, Buffer_Temp_Size);
+                delete[] Old; //Old=NULL;
+            }
+            Buffer_Temp_Begin=0;
+            Config->File_Buffer_Copied+=Buffer_Temp_Size;
         }
 
         //Copying buffer
         if (ToAdd_Size>0)
         {
-            memcpy_Unaligned_Unaligned(Buffer_Temp+Buffer_Size, ToAdd, ToAdd_Size);
+            memcpy_Unaligned_Unaligned(Buffer_Temp+Buffer_Temp_Begin+Buffer_Temp_Size, ToAdd, ToAdd_Size);
             Buffer_Temp_Size+=ToAdd_Size;
+            Config->File_Buffer_Copied+=ToAdd_Size;
         }
 
         //Buffer
-        Buffer=Buffer_Temp;
+        Buffer=Buffer_Temp+Buffer_Temp_Begin;
         Buffer_Size=Buffer_Temp_Size;
     }
     else
@@ -814,6 +871,7 @@ void File__Analyze::Open_Buffer_Continue (const int8u* ToAdd, size_t ToAdd_Size)
             {
                 if (Buffer_Temp!=NULL && Buffer_Temp_Size_Max<Buffer_Size-Buffer_Offset)
                 {
+                    Config->File_Memory_Release(Buffer_Temp_Size_Max);
                     delete[] Buffer_Temp; Buffer_Temp=NULL; Buffer_Temp_Size=0; Buffer_Temp_Size_Max=0;
                 }
                 if (Buffer_Temp==NULL)
@@ -822,19 +880,25 @@ void File__Analyze::Open_Buffer_Continue (const int8u* ToAdd, size_t ToAdd_Size)
                     if (Buffer_Temp_Size_Max_ToAdd<Buffer_Temp_Size_Max) Buffer_Temp_Size_Max_ToAdd=Buffer_Temp_Size_Max;
                     Buffer_Temp_Size_Max=Buffer_Temp_Size_Max_ToAdd;
                     Buffer_Temp=new int8u[Buffer_Temp_Size_Max];
+                    Config->File_Memory_Add(Buffer_Temp_Size_Max);
                 }
+                Buffer_Temp_Begin=0;
                 Buffer_Temp_Size=Buffer_Size-Buffer_Offset;
                 memcpy_Unaligned_Unaligned(Buffer_Temp, Buffer+Buffer_Offset, Buffer_Temp_Size);
+                Config->File_Buffer_Copied+=Buffer_Temp_Size;
             }
         }
-        else if (Buffer_Offset) //Already a copy, just moving it
+        else if (Buffer_Offset) //Already a copy, just skipping the consumed bytes
         {
-            std::memmove(Buffer_Temp, Buffer_Temp+Buffer_Offset, Buffer_Size-Buffer_Offset);
+            Buffer_Temp_Begin+=Buffer_Offset;
             Buffer_Temp_Size=Buffer_Size-Buffer_Offset;
         }
     }
     else if (Buffer_Temp_Size)
+    {
+        Buffer_Temp_Begin=0;
         Buffer_Temp_Size=0;
+    }
 
     //Reserving unused data
     if ((int64u)-1-Buffer_Offset<File_Offset) //In case of unknown filesize, File_Offset may be (int64u)-1
@@ -848,13 +912,14 @@ void File__Analyze::Open_Buffer_Continue (const int8u* ToAdd, size_t ToAdd_Size)
         }
 
         float64 Ratio=1;
-        if (OriginalBuffer)
+        if (OriginalBuffer_Size)
         {
             Ratio=((float64)OriginalBuffer_Size)/Buffer_Size;
             size_t Temp_Size=(size_t)float64_int64s(((float64)Buffer_Offset)*Ratio);
 
             OriginalBuffer_Size-=Temp_Size;
-            memmove(OriginalBuffer, OriginalBuffer+Buffer_Offset, OriginalBuffer_Size);
+            if (OriginalBuffer) //Only sizes are kept if original content is not demuxed
+                memmove(OriginalBuffer, OriginalBuffer+Buffer_Offset, OriginalBuffer_Size);
         }
 
         Buffer_Size-=Buffer_Offset;
@@ -1018,19 +1083,29 @@ void File__Analyze::Open_Buffer_Continue (File__Analyze* Sub, const int8u* ToAdd
         }
     }
 
-    if (Ratio!=1)
+    if (Ratio!=1
+        #if MEDIAINFO_DEMUX
+            && Config_Demux_OriginalContent
+        #endif //MEDIAINFO_DEMUX
+            )
     {
         if (Sub->OriginalBuffer_Size+Element_Size-Element_Offset>Sub->OriginalBuffer_Capacity)
         {
             int8u* Temp=Sub->OriginalBuffer;
             Sub->OriginalBuffer_Capacity=(size_t)(Sub->OriginalBuffer_Size+Element_Size-Element_Offset);
+            if (Sub->OriginalBuffer_Capacity<Sub->OriginalBuffer_Size*2)
+                Sub->OriginalBuffer_Capacity=Sub->OriginalBuffer_Size*2; //Geometric growth, for not copying again the same bytes on each packet
             Sub->OriginalBuffer=new int8u[Sub->OriginalBuffer_Capacity];
             memcpy_Unaligned_Unaligned(Sub->OriginalBuffer, Temp, Sub->OriginalBuffer_Size);
+            Config->File_Buffer_Copied+=Sub->OriginalBuffer_Size;
             delete[] Temp;
         }
         memcpy_Unaligned_Unaligned(Sub->OriginalBuffer+Sub->OriginalBuffer_Size, Buffer+Buffer_Offset+(size_t)Element_Offset, (size_t)(Element_Size-Element_Offset));
         Sub->OriginalBuffer_Size+=(size_t)(Element_Size-Element_Offset);
+        Config->File_Buffer_Copied+=Element_Size-Element_Offset;
     }
+    else if (Ratio!=1)
+        Sub->OriginalBuffer_Size+=(size_t)(Element_Size-Element_Offset); //Offsets stay coherent without copying the original content
 
     #if MEDIAINFO_ADVANCED2
         if (Frequency_c)
@@ -1123,6 +1198,7 @@ bool File__Analyze::Open_Buffer_Continue_Loop ()
             Buffer_Temp_Size=(size_t)(File_Offset+Buffer_Size-File_GoTo);
             if (Buffer_Temp!=NULL && Buffer_Temp_Size_Max<Buffer_Temp_Size)
             {
+                Config->File_Memory_Release(Buffer_Temp_Size_Max);
                 delete[] Buffer_Temp; Buffer_Temp=NULL; Buffer_Temp_Size=0; Buffer_Temp_Size_Max=0;
             }
             if (Buffer_Temp==NULL)
@@ -1131,16 +1207,19 @@ bool File__Analyze::Open_Buffer_Continue_Loop ()
                 if (Buffer_Temp_Size_Max_ToAdd<Buffer_Temp_Size_Max) Buffer_Temp_Size_Max_ToAdd=Buffer_Temp_Size_Max;
                 Buffer_Temp_Size_Max=Buffer_Temp_Size_Max_ToAdd;
                 Buffer_Temp=new int8u[Buffer_Temp_Size_Max];
+                Config->File_Memory_Add(Buffer_Temp_Size_Max);
             }
+            Buffer_Temp_Begin=0;
             memcpy_Unaligned_Unaligned(Buffer_Temp, Buffer+Buffer_Size-Buffer_Temp_Size, Buffer_Temp_Size);
+            Config->File_Buffer_Copied+=Buffer_Temp_Size;
         }
-        else //Already a copy, just moving it
+        else //Already a copy, just skipping the bytes before the seek point
         {
             Buffer_Temp_Size=(size_t)(File_Offset+Buffer_Size-File_GoTo);
-            std::memmove(Buffer_Temp, Buffer+Buffer_Size-Buffer_Temp_Size, Buffer_Temp_Size);
+            Buffer_Temp_Begin+=Buffer_Size-Buffer_Temp_Size;
         }
         File_Offset+=Buffer_Size-Buffer_Temp_Size;
-        Buffer=Buffer_Temp;
+        Buffer=Buffer_Temp+Buffer_Temp_Begin;
         Buffer_Offset=0;
         Buffer_Size=Buffer_Temp_Size;
         File_GoTo=(int64u)-1;
@@ -1318,7 +1397,9 @@ void File__Analyze::Open_Buffer_Finalize (bool NoBufferModification)
     }
 
     #if MEDIAINFO_TRACE
-    if (Details && Details->empty())
+    if (Trace_Stream)
+        Trace_Stream_Flush(true);
+    else if (Details && Details->empty())
         Element[0].TraceNode.Print(Config_Trace_Format, *Details, Config_LineSeparator.To_UTF8(), File_Size);
     #endif //MEDIAINFO_TRACE
 
@@ -1550,7 +1631,9 @@ void File__Analyze::Buffer_Clear()
 {
     //Buffer
     BS->Attach(NULL, 0);
-    delete[] Buffer_Temp; Buffer_Temp=NULL;
+    if (Buffer_Temp)
+        Config->File_Memory_Release(Buffer_Temp_Size_Max);
+    delete[] Buffer_Temp; Buffer_Temp=NULL; Buffer_Temp_Begin=0;
     if (!Status[IsFinished])
         File_Offset+=Buffer_Size;
     else
@@ -1621,6 +1704,48 @@ bool File__Analyze::Synchronize_0x000001()
     return true;
 }
 
+//---------------------------------------------------------------------------
+// Same as
+// while (Buffer_Offset+Size_Needed<=Buffer_Size && Buffer[Buffer_Offset+Value_Pos]!=Value)
+//     Buffer_Offset++;
+// but with memchr(), which is vectorized by most C libraries
+void File__Analyze::Synchronize_Byte(int8u Value, size_t Value_Pos, size_t Size_Needed)
+{
+    if (Buffer_Offset+Size_Needed>Buffer_Size)
+        return;
+
+    size_t ToSearch=Buffer_Size-Size_Needed+1-Buffer_Offset;
+    const int8u* Found=(const int8u*)memchr(Buffer+Buffer_Offset+Value_Pos, Value, ToSearch);
+    if (Found)
+        Buffer_Offset=Found-Buffer-Value_Pos;
+    else
+        Buffer_Offset+=ToSearch;
+}
+
+//---------------------------------------------------------------------------
+// Positions (from Buffer+Buffer_Offset) of the 0x03 byte of each 0x000003
+// sequence between Begin and End, jumping from 0x00 to 0x00 with memchr()
+void File__Analyze::Emulation_Prevention_Find(size_t Begin, size_t End, std::vector<size_t> &ThreeByte_List)
+{
+    const int8u* Base=Buffer+Buffer_Offset;
+    size_t Pos=Begin;
+    while (Pos+3<=End)
+    {
+        //Next 0x00 which may be the second byte of a sequence
+        const int8u* Zero=(const int8u*)memchr(Base+Pos+1, 0x00, End-Pos-2);
+        if (!Zero)
+            break;
+        size_t Zero_Pos=Zero-Base;
+        if (Base[Zero_Pos-1]==0x00 && Base[Zero_Pos+1]==0x03)
+        {
+            ThreeByte_List.push_back(Zero_Pos+1);
+            Pos=Zero_Pos+2;
+        }
+        else
+            Pos=Zero_Pos;
+    }
+}
+
 //---------------------------------------------------------------------------
 bool File__Analyze::FileHeader_Begin_0x000001()
 {
@@ -2276,7 +2401,7 @@ bool File__Analyze::Header_Manage()
     if (Trace_Activated)
     {
         if (Element[Element_Level-1].TraceNode.Name_Is_Empty())
-            Element[Element_Level-1].TraceNode.Set_Name("Unknown");
+            Element[Element_Level-1].TraceNode.Set_Name("Unknown", Element_Pool);
         Element[Element_Level].TraceNode.Size=Element_Offset;
         if (Element_Offset==0)
             Element_DoNotShow();
@@ -2708,10 +2833,10 @@ void File__Analyze::Element_Name(const Ztring &Name)
             Name2.FindAndReplace(__T("\n"), __T("_"), 0, Ztring_Recursive);
             if (Name2[0]==__T(' '))
                 Name2[0]=__T('_');
-            Element[Element_Level].TraceNode.Set_Name(Name2.To_UTF8());
+            Element[Element_Level].TraceNode.Set_Name(Name2.To_UTF8(), Element_Pool);
         }
         else
-            Element[Element_Level].TraceNode.Set_Name("(Empty)");
+            Element[Element_Level].TraceNode.Set_Name("(Empty)", Element_Pool);
     }
 }
 #endif //MEDIAINFO_TRACE
@@ -2724,7 +2849,7 @@ void File__Analyze::Element_Parser(const char* Parser)
     if (Config_Trace_Level<=0.7)
         return;
 
-    Element[Element_Level].TraceNode.Infos.push_back(new element_details::Element_Node_Info(Parser, "Parser"));
+    Element[Element_Level].TraceNode.Infos.push_back(new (Element_Pool) element_details::Element_Node_Info(Element_Pool, Parser, "Parser"));
 }
 #endif //MEDIAINFO_TRACE
 
@@ -2736,7 +2861,7 @@ void File__Analyze::Element_Error(const char* Message)
     if (Config_Trace_Level<=0.7)
         return;
 
-    Element[Element_Level].TraceNode.Infos.push_back(new element_details::Element_Node_Info(Message, "Error"));
+    Element[Element_Level].TraceNode.Infos.push_back(new (Element_Pool) element_details::Element_Node_Info(Element_Pool, Message, "Error"));
 }
 #endif //MEDIAINFO_TRACE
 
@@ -2768,7 +2893,7 @@ void File__Analyze::Element_End(const Ztring &Name)
     {
         Element[Element_Level].TraceNode.Size=Element[Element_Level].Next-Element[Element_Level].TraceNode.Pos;
         if (!Name.empty())
-            Element[Element_Level].TraceNode.Set_Name(Name.To_UTF8());
+            Element[Element_Level].TraceNode.Set_Name(Name.To_UTF8(), Element_Pool);
     }
 
     Element_End_Common_Flush();
@@ -2813,15 +2938,91 @@ void File__Analyze::Element_End_Common_Flush_Details()
         if (!Element[Element_Level+1].WaitForMoreData && (Element[Element_Level+1].IsComplete || !Element[Element_Level+1].UnTrusted) && !Element[Element_Level+1].TraceNode.NoShow)
         {
             //Element
-            Element[Element_Level].TraceNode.Add_Child(&Element[Element_Level+1].TraceNode);
+            size_t Children_Size=Element[Element_Level].TraceNode.Children.size();
+            Element[Element_Level].TraceNode.Add_Child(&Element[Element_Level+1].TraceNode, Element_Pool);
 
             //Info
             if (!Element[Element_Level+1].TraceNode.Value.empty())
                 Element[Element_Level].TraceNode.Value=Element[Element_Level+1].TraceNode.Value;
             Element[Element_Level+1].TraceNode.Init();
+
+            //Streaming
+            if (Trace_Stream && !Element_Level)
+                Trace_Stream_Flush();
+
+            //Memory budget
+            if (!Element_Level && !IsSub && Element[0].TraceNode.Children.size()>Children_Size)
+                Trace_Memory_Check();
         }
     }
 }
+
+//---------------------------------------------------------------------------
+static int64u Trace_Memory_Size(const element_details::Element_Node* Node)
+{
+    int64u Size=sizeof(element_details::Element_Node)+Node->Infos.size()*sizeof(element_details::Element_Node_Info);
+    for (size_t i=0; i<Node->Children.size(); ++i)
+        Size+=Trace_Memory_Size(Node->Children[i]);
+    return Size;
+}
+
+//---------------------------------------------------------------------------
+void File__Analyze::Trace_Memory_Check()
+{
+    //The last top level element is accounted once complete, trace is skipped from here if the budget is exceeded
+    element_details::Element_Node& Root=Element[0].TraceNode;
+    int64u Size=Trace_Memory_Size(Root.Children.back());
+    if (Config->File_Memory_Reserve(Size))
+        Trace_Memory+=Size;
+    else
+    {
+        delete Root.Children.back();
+        Root.Children.pop_back();
+        Root.Current_Child=-1;
+        Trace_Activated=false;
+    }
+}
+
+//---------------------------------------------------------------------------
+void File__Analyze::Trace_Stream_Flush(bool Force)
+{
+    //Top level elements are written as soon as they are complete, only if the root node is not displayed itself
+    element_details::Element_Node& Root=Element[0].TraceNode;
+    if (!Root.NoShow && !Root.IsCat && Root.Name_Is_Empty() && Root.OwnChildren)
+    {
+        for (size_t i=0; i<Root.Children.size(); ++i)
+        {
+            std::string Str;
+            Root.Children[i]->Print(Config_Trace_Format, Str, Config_LineSeparator.To_UTF8(), File_Size);
+            Trace_Stream_Buffer+=Str;
+            delete Root.Children[i];
+        }
+        Root.Children.clear();
+        Root.Current_Child=-1;
+    }
+    else if (Force)
+    {
+        std::string Str;
+        Root.Print(Config_Trace_Format, Str, Config_LineSeparator.To_UTF8(), File_Size);
+        Trace_Stream_Buffer+=Str;
+        Root.Init();
+        Config->File_Memory_Release(Trace_Memory);
+        Trace_Memory=0;
+    }
+
+    //Writing by blocks
+    if (Trace_Stream_Buffer.size()>=1024*1024 || (Force && !Trace_Stream_Buffer.empty()))
+    {
+        if (Trace_Stream->Write((const int8u*)Trace_Stream_Buffer.data(), Trace_Stream_Buffer.size())!=Trace_Stream_Buffer.size())
+        {
+            //Disk full or similar, no more trace
+            MediaInfoLib::Config.Log_Send(0xC0, 0xFF, 0, __T("Trace file write error"));
+            Trace_Stream=NULL;
+            Trace_Activated=false;
+        }
+        Trace_Stream_Buffer.clear();
+    }
+}
 #endif //MEDIAINFO_TRACE
 
 //---------------------------------------------------------------------------
@@ -2852,10 +3053,10 @@ void File__Analyze::Info(const std::string& Value, size_t Element_Level_Minus)
 
     element_details::Element_Node node;
     node.Init();
-    node.Set_Name(Value);
+    node.Set_Name(Value, Element_Pool);
     node.IsCat = true;
     node.Pos = File_Offset+Buffer_Offset+Element_Offset+BS->Offset_Get();
-    Element[Element_Level].TraceNode.Add_Child(&node);
+    Element[Element_Level].TraceNode.Add_Child(&node, Element_Pool);
 }
 #endif //MEDIAINFO_TRACE
 
@@ -3548,7 +3749,7 @@ void File__Analyze::Element_Show_Add (File__Analyze* node)
         return;
 
     //From Sub
-    Element[Element_Level].TraceNode.Add_Child(&node->Element[0].TraceNode);
+    Element[Element_Level].TraceNode.Add_Child(&node->Element[0].TraceNode, Element_Pool);
     node->Element[0].TraceNode.Init();
 }
 #endif //MEDIAINFO_TRACE
@@ -3763,8 +3964,8 @@ void File__Analyze::Demux (const int8u* Buffer, size_t Buffer_Size, contenttype
                 Event.Offsets_Stream=&Offsets_Stream.front();
                 Event.Offsets_Content=&Offsets_Buffer.front();
             }
-            Event.OriginalContent_Size=OriginalBuffer_Size?((size_t)float64_int64s(((float64)(Element_Size-Element_Offset))*Ratio)):0;
-            Event.OriginalContent=OriginalBuffer_Size?(OriginalBuffer+(size_t)float64_int64s(((float64)(Buffer_Offset+Element_Offset))*Ratio)):NULL;
+            Event.OriginalContent_Size=OriginalBuffer?((size_t)float64_int64s(((float64)(Element_Size-Element_Offset))*Ratio)):0;
+            Event.OriginalContent=OriginalBuffer?(OriginalBuffer+(size_t)float64_int64s(((float64)(Buffer_Offset+Element_Offset))*Ratio)):NULL;
         EVENT_END()
 
         if (StreamIDs_Size)
@@ -3915,30 +4116,25 @@ size_t File__Analyze::Ibi_Read_Buffer_Seek (size_t Method, int64u Value, int64u
         case 0  :
                     #if MEDIAINFO_IBI
                     {
-                    for (size_t Pos=0; Pos<IbiStream->Infos.size(); Pos++)
+                    size_t Pos=IbiStream->Find(&ibi::stream::info::StreamOffset, Value);
+                    if (Pos<IbiStream->Infos.size())
                     {
-                        if (Value<=IbiStream->Infos[Pos].StreamOffset)
+                        //Checking continuity of Ibi
+                        if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
                         {
-                            if (Value<IbiStream->Infos[Pos].StreamOffset && Pos)
-                                Pos--;
-
-                            //Checking continuity of Ibi
-                            if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
-                            {
-                                Config->Demux_IsSeeking=true;
-                                GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
-                                Open_Buffer_Unsynch();
-
-                                return 1;
-                            }
-
-                            Config->Demux_IsSeeking=false;
-
-                            GoTo(IbiStream->Infos[Pos].StreamOffset);
+                            Config->Demux_IsSeeking=true;
+                            GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
                             Open_Buffer_Unsynch();
 
                             return 1;
                         }
+
+                        Config->Demux_IsSeeking=false;
+
+                        GoTo(IbiStream->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
+
+                        return 1;
                     }
 
                     if (IbiStream->Infos.empty())
@@ -3972,30 +4168,25 @@ size_t File__Analyze::Ibi_Read_Buffer_Seek (size_t Method, int64u Value, int64u
                         Value=float64_int64s(ValueF);
                     }
 
-                    for (size_t Pos=0; Pos<IbiStream->Infos.size(); Pos++)
+                    size_t Pos=IbiStream->Find(&ibi::stream::info::Dts, Value);
+                    if (Pos<IbiStream->Infos.size())
                     {
-                        if (Value<=IbiStream->Infos[Pos].Dts)
+                        //Checking continuity of Ibi
+                        if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
                         {
-                            if (Value<IbiStream->Infos[Pos].Dts && Pos)
-                                Pos--;
-
-                            //Checking continuity of Ibi
-                            if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
-                            {
-                                Config->Demux_IsSeeking=true;
-                                GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
-                                Open_Buffer_Unsynch();
-
-                                return 1;
-                            }
-
-                            Config->Demux_IsSeeking=false;
-
-                            GoTo(IbiStream->Infos[Pos].StreamOffset);
+                            Config->Demux_IsSeeking=true;
+                            GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
                             Open_Buffer_Unsynch();
 
                             return 1;
                         }
+
+                        Config->Demux_IsSeeking=false;
+
+                        GoTo(IbiStream->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
+
+                        return 1;
                     }
 
                     if (IbiStream->Infos.empty())
@@ -4018,30 +4209,25 @@ size_t File__Analyze::Ibi_Read_Buffer_Seek (size_t Method, int64u Value, int64u
         case 3  :   //FrameNumber
                     #if MEDIAINFO_IBI
                     {
-                    for (size_t Pos=0; Pos<IbiStream->Infos.size(); Pos++)
+                    size_t Pos=IbiStream->Find(&ibi::stream::info::FrameNumber, Value);
+                    if (Pos<IbiStream->Infos.size())
                     {
-                        if (Value<=IbiStream->Infos[Pos].FrameNumber)
+                        //Checking continuity of Ibi
+                        if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
                         {
-                            if (Value<IbiStream->Infos[Pos].FrameNumber && Pos)
-                                Pos--;
-
-                            //Checking continuity of Ibi
-                            if (!IbiStream->Infos[Pos].IsContinuous && Pos+1<IbiStream->Infos.size())
-                            {
-                                Config->Demux_IsSeeking=true;
-                                GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
-                                Open_Buffer_Unsynch();
-
-                                return 1;
-                            }
-
-                            Config->Demux_IsSeeking=false;
-
-                            GoTo(IbiStream->Infos[Pos].StreamOffset);
+                            Config->Demux_IsSeeking=true;
+                            GoTo((IbiStream->Infos[Pos].StreamOffset+IbiStream->Infos[Pos+1].StreamOffset)/2);
                             Open_Buffer_Unsynch();
 
                             return 1;
                         }
+
+                        Config->Demux_IsSeeking=false;
+
+                        GoTo(IbiStream->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
+
+                        return 1;
                     }
 
                     if (IbiStream->Infos.empty())
@@ -2060,7 +2060,7 @@ void File__Analyze::Get_Flags (int64u Flags, size_t Order, bool &Info, const cha
         Info=false;
 
     Element_Begin0();
-    if (Trace_Activated && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_XML && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, Info);
+    if (Trace_Activated && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_XML && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, Info);
     Element_End0();
 }
 
@@ -2070,7 +2070,7 @@ void File__Analyze::Get_Flags (int64u ValueToPut, int8u &Info, const char* Name)
     Info=(int8u)ValueToPut;
 
     Element_Begin0();
-    if (Trace_Activated && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_XML && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, Info);
+    if (Trace_Activated && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_XML && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, Info);
     Element_End0();
 }
 
@@ -2078,7 +2078,7 @@ void File__Analyze::Get_Flags (int64u ValueToPut, int8u &Info, const char* Name)
 void File__Analyze::Skip_Flags(int64u Flags, size_t Order, const char* Name)
 {
     Element_Begin0();
-    if (Trace_Activated && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_XML && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, (Flags&((int64u)1<<Order))); //TODO: support flags in XML trace
+    if (Trace_Activated && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_XML && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, (Flags&((int64u)1<<Order))); //TODO: support flags in XML trace
     Element_End0();
 }
 
@@ -2086,7 +2086,7 @@ void File__Analyze::Skip_Flags(int64u Flags, size_t Order, const char* Name)
 void File__Analyze::Skip_Flags(int64u ValueToPut, const char* Name)
 {
     Element_Begin0();
-    if (Trace_Activated && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_XML && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, ValueToPut);
+    if (Trace_Activated && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_XML && Config_Trace_Format!=MediaInfoLib::Config.Trace_Format_MICRO_XML) Param(Name, ValueToPut);
     Element_End0();
 }
 
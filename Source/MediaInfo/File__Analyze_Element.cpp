@@ -27,6 +27,194 @@
 namespace MediaInfoLib
 {
 #if MEDIAINFO_TRACE
+//***************************************************************************
+// Element_Node_Pool
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+//Objects are split in size classes, freed objects are kept in a list per class
+//Each object is preceded by a header with its pool, so it can be freed from another parser tree
+static const size_t Pool_Granularity=16;
+static const size_t Pool_Classes=16; //Up to 256 bytes with the header, bigger objects use the heap
+static const size_t Pool_Header_Size=16; //Keeps the alignment of the objects
+static const size_t Pool_Chunk_Size_Min=4*1024; //Most sub-parsers create few nodes
+static const size_t Pool_Chunk_Size_Max=64*1024;
+static const size_t Pool_Interned_MaxSize=64; //Longer names are usually built from data
+static const size_t Pool_Interned_MaxTotal=1024*1024;
+
+struct pool_header
+{
+    element_details::Element_Node_Pool* Pool; //NULL if allocated on the heap
+    size_t                              Class;
+};
+
+//---------------------------------------------------------------------------
+element_details::Element_Node_Pool::Element_Node_Pool()
+: Chunk_Size(Pool_Chunk_Size_Min), Chunk_Used(0), Names_Total(0), Refs(1)
+{
+    memset(FreeLists, 0, sizeof(FreeLists));
+}
+
+//---------------------------------------------------------------------------
+element_details::Element_Node_Pool::~Element_Node_Pool()
+{
+    for (size_t Pos=0; Pos<Chunks.size(); Pos++)
+        delete[] Chunks[Pos];
+    for (std::set<name>::iterator Name=Names.begin(); Name!=Names.end(); ++Name)
+        delete[] Name->Str;
+}
+
+//---------------------------------------------------------------------------
+void element_details::Element_Node_Pool::Release()
+{
+    Refs--;
+    if (!Refs)
+        delete this;
+}
+
+//---------------------------------------------------------------------------
+void* element_details::Element_Node_Pool::Alloc(size_t Size, Element_Node_Pool* Pool)
+{
+    size_t Class=(Pool_Header_Size+Size+Pool_Granularity-1)/Pool_Granularity;
+    if (!Pool || Class>Pool_Classes)
+    {
+        pool_header* Header=(pool_header*)::operator new(Pool_Header_Size+Size);
+        Header->Pool=NULL;
+        Header->Class=0;
+        return (char*)Header+Pool_Header_Size;
+    }
+    Class--;
+
+    pool_header* Header;
+    if (Pool->FreeLists[Class])
+    {
+        Header=(pool_header*)Pool->FreeLists[Class];
+        Pool->FreeLists[Class]=Pool->FreeLists[Class]->Next;
+    }
+    else
+    {
+        size_t Class_Size=(Class+1)*Pool_Granularity;
+        if (Pool->Chunks.empty() || Pool->Chunk_Used+Class_Size>Pool->Chunk_Size)
+        {
+            if (!Pool->Chunks.empty() && Pool->Chunk_Size<Pool_Chunk_Size_Max)
+                Pool->Chunk_Size*=2;
+            Pool->Chunks.push_back(new char[Pool->Chunk_Size]);
+            Pool->Chunk_Used=0;
+        }
+        Header=(pool_header*)(Pool->Chunks.back()+Pool->Chunk_Used);
+        Pool->Chunk_Used+=Class_Size;
+    }
+    Header->Pool=Pool;
+    Header->Class=Class;
+    Pool->Refs++;
+    return (char*)Header+Pool_Header_Size;
+}
+
+//---------------------------------------------------------------------------
+void element_details::Element_Node_Pool::Free(void* Ptr)
+{
+    if (!Ptr)
+        return;
+    pool_header* Header=(pool_header*)((char*)Ptr-Pool_Header_Size);
+    Element_Node_Pool* Pool=Header->Pool;
+    if (!Pool)
+    {
+        ::operator delete(Header);
+        return;
+    }
+
+    size_t Class=Header->Class;
+    free_item* Item=(free_item*)Header;
+    Item->Next=Pool->FreeLists[Class];
+    Pool->FreeLists[Class]=Item;
+    Pool->Release();
+}
+
+//---------------------------------------------------------------------------
+const char* element_details::Element_Node_Pool::Intern(const char* Str, size_t Str_Size)
+{
+    if (Str_Size>Pool_Interned_MaxSize)
+        return NULL;
+
+    name Name;
+    Name.Str=Str;
+    Name.Size=Str_Size;
+
+    std::set<name>::iterator Item=Names.find(Name);
+    if (Item!=Names.end())
+    {
+        Refs++;
+        return Item->Str;
+    }
+    if (Names_Total+Str_Size>Pool_Interned_MaxTotal)
+        return NULL;
+
+    //Interned names are kept until the pool is deleted
+    char* Str_New=new char[Str_Size+1];
+    memcpy(Str_New, Str, Str_Size);
+    Str_New[Str_Size]='\0';
+    Name.Str=Str_New;
+    Names.insert(Name);
+    Names_Total+=Str_Size;
+    Refs++;
+    return Str_New;
+}
+
+//***************************************************************************
+// Element_Node_String
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+element_details::Element_Node_String& element_details::Element_Node_String::operator=(const Element_Node_String& v)
+{
+    if (this == &v)
+        return *this;
+
+    if (v.Pool)
+    {
+        v.Pool->AddRef();
+        clear();
+        Str = v.Str;
+        Size = v.Size;
+        Pool = v.Pool;
+    }
+    else
+        assign(v.Str, v.Size);
+    return *this;
+}
+
+//---------------------------------------------------------------------------
+void element_details::Element_Node_String::assign(const char* v, size_t v_Size, Element_Node_Pool* Pool_)
+{
+    clear();
+    if (!v_Size)
+        return;
+
+    Str = Pool_ ? Pool_->Intern(v, v_Size) : NULL;
+    if (Str)
+        Pool = Pool_;
+    else
+    {
+        char* Str_New = new char[v_Size + 1];
+        std::memcpy(Str_New, v, v_Size);
+        Str_New[v_Size] = '\0';
+        Str = Str_New;
+    }
+    Size = (int32u)v_Size;
+}
+
+//---------------------------------------------------------------------------
+void element_details::Element_Node_String::clear()
+{
+    if (Pool)
+        Pool->Release();
+    else if (Str)
+        delete[] Str;
+    Str = NULL;
+    Size = 0;
+    Pool = NULL;
+}
+
 //***************************************************************************
 // Element_Node_Data
 //***************************************************************************
@@ -706,11 +894,11 @@ int element_details::Element_Node::Print_Micro_Xml(print_struc& s)
         s.ss << "<d";
 
     {
-    size_t MustEscape = Xml_Content_Escape_MustEscape(Name);
+    size_t MustEscape = Xml_Content_Escape_MustEscape(Name.c_str(), Name.size());
     if (MustEscape != (size_t)-1)
     {
         std::string str;
-        Xml_Content_Escape(Name, str, MustEscape);
+        Xml_Content_Escape(Name.c_str(), Name.size(), str, MustEscape);
         s.ss << " o=\"" << Pos << "\" n=\"" << str << "\"";
     }
     else
@@ -789,11 +977,11 @@ int element_details::Element_Node::Print_Xml(print_struc& s)
         s.ss << "<data";
 
     {
-    size_t MustEscape = Xml_Content_Escape_MustEscape(Name);
+    size_t MustEscape = Xml_Content_Escape_MustEscape(Name.c_str(), Name.size());
     if (MustEscape != (size_t)-1)
     {
         std::string str;
-        Xml_Content_Escape(Name, str, MustEscape);
+        Xml_Content_Escape(Name.c_str(), Name.size(), str, MustEscape);
         s.ss << " offset=\"" << Pos << "\" name=\"" << str << "\"";
     }
     else
@@ -865,7 +1053,7 @@ int element_details::Element_Node::Print_Tree_Cat(print_struc& s)
 
     std::string ToShow;
     ToShow += "---   ";
-    ToShow += Name;
+    ToShow.append(Name.c_str(), Name.size());
     ToShow += "   ---";
 
     std::string minuses;
@@ -901,7 +1089,7 @@ int element_details::Element_Node::Print_Tree(print_struc& s)
     if (!Value.empty())
     {
         s.ss << ":";
-        int nb_free = NB_SPACES - s.level - (Name_Is_Empty() ? 0 : Name.length()); // 40 - len(Name) - len(spaces)
+        int nb_free = NB_SPACES - s.level - (Name_Is_Empty() ? 0 : Name.size()); // 40 - len(Name) - len(spaces)
         spaces.resize(nb_free > 0 ? nb_free : 1, ' ');
         Value.Set_Output_Format(Element_Node_Data::Format_Tree);
         s.ss << spaces << Value;
@@ -984,7 +1172,7 @@ int element_details::Element_Node::Print(MediaInfo_Config::trace_Format Format,
 }
 
 //---------------------------------------------------------------------------
-void element_details::Element_Node::Add_Child(Element_Node* node)
+void element_details::Element_Node::Add_Child(Element_Node* node, Element_Node_Pool* Pool)
 {
     if (node->HasError)
     {
@@ -999,7 +1187,7 @@ void element_details::Element_Node::Add_Child(Element_Node* node)
         return;
     }
 
-    Element_Node *new_node = new Element_Node(*node);
+    Element_Node *new_node = new (Pool) Element_Node(*node);
     node->OwnChildren = false;
     Children.push_back(new_node);
 }
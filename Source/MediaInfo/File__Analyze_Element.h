@@ -11,6 +11,8 @@
 
 #include "MediaInfo/MediaInfo_Config.h"
 #include <sstream>
+#include <cstring>
+#include <set>
 //---------------------------------------------------------------------------
 
 namespace MediaInfoLib
@@ -20,6 +22,73 @@ namespace MediaInfoLib
 struct element_details
 {
 #if MEDIAINFO_TRACE
+    //Memory pool for trace nodes, big files create millions of them
+    //One pool per parser tree, used by one thread at a time so there is no lock
+    //Objects and interned names keep a reference, the pool is deleted with the last one
+    class Element_Node_Pool
+    {
+    public:
+        Element_Node_Pool();
+        void AddRef() {Refs++;}
+        void Release();
+        const char* Intern(const char* Str, size_t Str_Size); //NULL if not interned, else a reference is added
+
+        static void* Alloc(size_t Size, Element_Node_Pool* Pool); //Pool may be NULL (heap)
+        static void  Free(void* Ptr);
+
+    private:
+        ~Element_Node_Pool();
+        Element_Node_Pool(const Element_Node_Pool&);
+        Element_Node_Pool& operator=(const Element_Node_Pool&);
+
+        struct free_item
+        {
+            free_item* Next;
+        };
+        struct name
+        {
+            const char* Str;
+            size_t      Size;
+            bool operator<(const name& v) const
+            {
+                int Result=memcmp(Str, v.Str, Size<v.Size?Size:v.Size);
+                return Result?(Result<0):(Size<v.Size);
+            }
+        };
+
+        free_item*          FreeLists[16];
+        std::vector<char*>  Chunks;
+        size_t              Chunk_Size;
+        size_t              Chunk_Used;
+        std::set<name>      Names;
+        size_t              Names_Total;
+        size_t              Refs;
+    };
+
+    //Compact string, shared with other nodes when interned
+    class Element_Node_String
+    {
+    public:
+        Element_Node_String() : Str(NULL), Size(0), Pool(NULL) {}
+        Element_Node_String(const Element_Node_String& v) : Str(NULL), Size(0), Pool(NULL) {*this=v;}
+        ~Element_Node_String() {clear();}
+
+        Element_Node_String& operator=(const Element_Node_String& v);
+        void assign(const char* v, size_t v_Size, Element_Node_Pool* Pool_=NULL); //Interned in Pool_ if possible
+        void clear();
+        bool empty() const {return !Size;}
+        size_t size() const {return Size;}
+        const char* c_str() const {return Size?Str:"";}
+
+        bool operator==(const char* v) const {return strlen(v)==Size && !memcmp(c_str(), v, Size);}
+        friend std::ostream& operator<<(std::ostream& os, const Element_Node_String& v) {return os.write(v.c_str(), v.Size);}
+
+    private:
+        const char*         Str;
+        int32u              Size;
+        Element_Node_Pool*  Pool; //Interned in this pool, else owned
+    };
+
     class Element_Node_Data
     {
     public:
@@ -117,13 +186,26 @@ struct element_details
             data.set_Option(Option);
             data = parameter;
             if (_Measure)
-                Measure = _Measure;
+                Measure.assign(_Measure, strlen(_Measure));
+        }
+        template<typename T>
+        Element_Node_Info(Element_Node_Pool* Pool, T parameter, const char* _Measure=NULL, int8u Option=(int8u)-1)
+        {
+            data.set_Option(Option);
+            data = parameter;
+            if (_Measure)
+                Measure.assign(_Measure, strlen(_Measure), Pool);
         }
 
+        static void* operator new(size_t Size) {return Element_Node_Pool::Alloc(Size, NULL);}
+        static void* operator new(size_t Size, Element_Node_Pool* Pool) {return Element_Node_Pool::Alloc(Size, Pool);}
+        static void operator delete(void* Ptr) {Element_Node_Pool::Free(Ptr);}
+        static void operator delete(void* Ptr, Element_Node_Pool*) {Element_Node_Pool::Free(Ptr);}
+
         friend std::ostream& operator<<(std::ostream& os, element_details::Element_Node_Info* v);
 
-        Element_Node_Data data;
-        std::string       Measure;
+        Element_Node_Data   data;
+        Element_Node_String Measure;
 
     private:
         Element_Node_Info& operator=(const Element_Node_Info&);
@@ -137,13 +219,18 @@ struct element_details
         Element_Node(const Element_Node& node);
         ~Element_Node();
 
+        static void* operator new(size_t Size) {return Element_Node_Pool::Alloc(Size, NULL);}
+        static void* operator new(size_t Size, Element_Node_Pool* Pool) {return Element_Node_Pool::Alloc(Size, Pool);}
+        static void operator delete(void* Ptr) {Element_Node_Pool::Free(Ptr);}
+        static void operator delete(void* Ptr, Element_Node_Pool*) {Element_Node_Pool::Free(Ptr);}
+
         // Move
         void TakeChilrenFrom(Element_Node& node);
 
         int64u                           Pos;             // Position of the element in the file
         int64u                           Size;            // Size of the element (including header and sub-elements)
     private:
-        std::string                      Name;            // Name planned for this element
+        Element_Node_String              Name;            // Name planned for this element
     public:
         Element_Node_Data                Value;           // The value (currently used only with Trace XML)
         std::vector<Element_Node_Info*>  Infos;           // More info about the element
@@ -156,10 +243,10 @@ struct element_details
         bool                             RemoveIfNoErrors;// Remove Children Node if no NOK appears
 
         void                             Init();          //Initialize with common values
-        void Add_Child(Element_Node* node);               //Add a subchild to the current node
-        void Set_Name(const string &Name_)
+        void Add_Child(Element_Node* node, Element_Node_Pool* Pool=NULL); //Add a subchild to the current node
+        void Set_Name(const string &Name_, Element_Node_Pool* Pool=NULL)
         {
-            Name = Name_;
+            Name.assign(Name_.c_str(), Name_.size(), Pool);
         }
         bool Name_Is_Empty() const {return Name.empty();}
 
@@ -191,8 +191,8 @@ size_t File__Analyze::Stream_Prepare (stream_t KindOfStream, size_t StreamPos)
 
     //Filling basic info
     Fill(StreamKind_Last, StreamPos_Last, (size_t)General_Count, Count_Get(StreamKind_Last, StreamPos_Last));
-    Fill(StreamKind_Last, StreamPos_Last, General_StreamKind, MediaInfoLib::Config.Info_Get(StreamKind_Last).Read(General_StreamKind, Info_Text));
-    Fill(StreamKind_Last, StreamPos_Last, General_StreamKind_String, MediaInfoLib::Config.Language_Get(MediaInfoLib::Config.Info_Get(StreamKind_Last).Read(General_StreamKind, Info_Text)), true);
+    Fill(StreamKind_Last, StreamPos_Last, General_StreamKind, Config_Info_Get(StreamKind_Last).Read(General_StreamKind, Info_Text));
+    Fill(StreamKind_Last, StreamPos_Last, General_StreamKind_String, MediaInfoLib::Config.Language_Get(Config_Info_Get(StreamKind_Last).Read(General_StreamKind, Info_Text)), true);
     for (size_t Pos=0; Pos<Count_Get(KindOfStream); Pos++)
     {
         Fill(StreamKind_Last, Pos, General_StreamCount, Count_Get(StreamKind_Last), 10, true);
@@ -421,9 +421,9 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, size_t Paramete
         return;
 
     //Remove deprecated fields
-    if (!MediaInfoLib::Config.Legacy_Get())
+    if (!Config_Legacy)
     {
-        const Ztring& Info=MediaInfoLib::Config.Info_Get(StreamKind, Parameter, Info_Info);
+        const Ztring& Info=Config_Info_Get(StreamKind, Parameter, Info_Info);
         if (Info.size()>9 && Info[0]==__T('D') && Info[1]==__T('e') && Info[2]==__T('p') && Info[3]==__T('r') && Info[4]==__T('e') && Info[5]==__T('c') && Info[6]==__T('a') && Info[7]==__T('t') && Info[8]==__T('e') && Info[9]==__T('d'))
             return;
     }
@@ -472,7 +472,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, size_t Paramete
     //Handling values with \r\n inside
     if (Value.find_first_of(__T("\r\n"))!=string::npos)
     {
-        Ztring CarriageReturnReplace=MediaInfoLib::Config.CarriageReturnReplace_Get();
+        const Ztring &CarriageReturnReplace=Config_CarriageReturnReplace;
         if (!CarriageReturnReplace.empty())
         {
             Ztring NewValue=Value;
@@ -541,7 +541,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, size_t Paramete
         Target=Value; //First value
     else
     {
-        Target+=MediaInfoLib::Config.TagSeparator_Get();
+        Target+=Config_TagSeparator;
         Target+=Value;
     }
     Status[IsUpdated]=true;
@@ -621,8 +621,6 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, size_t Paramete
 
     if (!IsSub)
     {
-        Ztring ParameterName=Retrieve(StreamKind, StreamPos, Parameter, Info_Name);
-
         //General Format
         if (Parameter==Fill_Parameter(StreamKind, Generic_Format) && Retrieve(Stream_General, 0, General_Format).empty() && !Value.empty() && Count_Get(Stream_Video)+Count_Get(Stream_Audio)+Count_Get(Stream_Text)+Count_Get(Stream_Other)+Count_Get(Stream_Image)==1)
             Fill(Stream_General, 0, General_Format, Value); //If not already filled, we are filling with the stream format
@@ -653,7 +651,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, size_t Paramete
                 Fill(Stream_General, 0, General_Codec_String, Value, true);
             }
         }
-        if (MediaInfoLib::Config.Legacy_Get())
+        if (Config_Legacy)
         {
         if (StreamKind==Stream_General && Parameter==General_Format_Info)
             (*Stream)[Stream_General][0](General_Codec_Info)=Value;
@@ -1119,7 +1117,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, const char* Par
     //Handling values with \r\n inside
     if (Value.find_first_of(__T("\r\n"))!=string::npos)
     {
-        Ztring CarriageReturnReplace=MediaInfoLib::Config.CarriageReturnReplace_Get();
+        const Ztring &CarriageReturnReplace=Config_CarriageReturnReplace;
         if (!CarriageReturnReplace.empty())
         {
             Ztring NewValue=Value;
@@ -1171,7 +1169,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, const char* Par
 
     //Handling of well known parameters
     const Ztring Parameter_Local = Ztring().From_UTF8(Parameter);
-    const size_t Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Parameter_Local);
+    const size_t Pos=Config_Info_Find(StreamKind, Parameter_Local);
     if (Pos!=Error)
     {
         Fill(StreamKind, StreamPos, Pos, Value, Replace);
@@ -1222,7 +1220,7 @@ void File__Analyze::Fill (stream_t StreamKind, size_t StreamPos, const char* Par
         }
         else
         {
-            Target+=MediaInfoLib::Config.TagSeparator_Get();
+            Target+=Config_TagSeparator;
             Target+=Value;
         }
     }
@@ -1271,7 +1269,7 @@ void File__Analyze::Fill_SetOptions(stream_t StreamKind, size_t StreamPos, const
     }
 
     //Handling of well known parameters
-    size_t Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Ztring().From_UTF8(Parameter));
+    size_t Pos=Config_Info_Find(StreamKind, Ztring().From_UTF8(Parameter));
     if (Pos!=Error)
     {
         //We can not change that
@@ -1281,13 +1279,56 @@ void File__Analyze::Fill_SetOptions(stream_t StreamKind, size_t StreamPos, const
     (*Stream_More)[StreamKind][StreamPos](Ztring().From_ISO_8859_1(Parameter), Info_Options).From_UTF8(Options);
 }
 
+//---------------------------------------------------------------------------
+void File__Analyze::Config_Info_Load (stream_t StreamKind)
+{
+    //Only the first call per parser takes the global config lock, the table and its index are from the same copy
+    const MediaInfo_Config::info_snapshot* Snapshot=MediaInfoLib::Config.Info_Snapshot_Get(StreamKind);
+    Config_Info[StreamKind]=&Snapshot->Info;
+    Config_Info_Index[StreamKind]=&Snapshot->Index;
+}
+
+//---------------------------------------------------------------------------
+const ZtringListList &File__Analyze::Config_Info_Get (stream_t StreamKind)
+{
+    if (StreamKind>=Stream_Max)
+        return MediaInfoLib::Config.EmptyStringListList_Get();
+
+    if (!Config_Info[StreamKind])
+        Config_Info_Load(StreamKind);
+    return *Config_Info[StreamKind];
+}
+
+//---------------------------------------------------------------------------
+const Ztring &File__Analyze::Config_Info_Get (stream_t StreamKind, size_t Pos, info_t KindOfInfo)
+{
+    const ZtringListList &Info=Config_Info_Get(StreamKind);
+    if (Pos>=Info.size() || (size_t)KindOfInfo>=Info[Pos].size())
+        return MediaInfoLib::Config.EmptyString_Get();
+    return Info[Pos][KindOfInfo];
+}
+
+//---------------------------------------------------------------------------
+size_t File__Analyze::Config_Info_Find (stream_t StreamKind, const Ztring &Value)
+{
+    if (StreamKind>=Stream_Max)
+        return Error;
+
+    if (!Config_Info_Index[StreamKind])
+        Config_Info_Load(StreamKind);
+    std::map<Ztring, size_t>::const_iterator Item=Config_Info_Index[StreamKind]->find(Value);
+    if (Item==Config_Info_Index[StreamKind]->end())
+        return Error;
+    return Item->second;
+}
+
 //---------------------------------------------------------------------------
 const Ztring &File__Analyze::Retrieve_Const (stream_t StreamKind, size_t StreamPos, size_t Parameter, info_t KindOfInfo)
 {
     //Integrity
     if (StreamKind>=Stream_Max
      || StreamPos>=(*Stream)[StreamKind].size()
-     || Parameter>=MediaInfoLib::Config.Info_Get(StreamKind).size()+(*Stream_More)[StreamKind][StreamPos].size())
+     || Parameter>=Config_Info_Get(StreamKind).size()+(*Stream_More)[StreamKind][StreamPos].size())
     {
         if (StreamKind<sizeof(Fill_Temp)/sizeof(vector<fill_temp_item>))
         {
@@ -1301,16 +1342,16 @@ const Ztring &File__Analyze::Retrieve_Const (stream_t StreamKind, size_t StreamP
         return MediaInfoLib::Config.EmptyString_Get();
     }
 
-    if (Parameter>=MediaInfoLib::Config.Info_Get(StreamKind).size())
+    if (Parameter>=Config_Info_Get(StreamKind).size())
     {
-        Parameter-=MediaInfoLib::Config.Info_Get(StreamKind).size();
+        Parameter-=Config_Info_Get(StreamKind).size();
         if (KindOfInfo>=(*Stream_More)[StreamKind][StreamPos][Parameter].size())
             return MediaInfoLib::Config.EmptyString_Get();
         return (*Stream_More)[StreamKind][StreamPos][Parameter][KindOfInfo];
     }
 
     if (KindOfInfo!=Info_Text)
-        return MediaInfoLib::Config.Info_Get(StreamKind, Parameter, KindOfInfo);
+        return Config_Info_Get(StreamKind, Parameter, KindOfInfo);
 
     if (StreamKind>=(*Stream).size() || StreamPos>=(*Stream)[StreamKind].size() || Parameter>=(*Stream)[StreamKind][StreamPos].size())
         return MediaInfoLib::Config.EmptyString_Get();
@@ -1323,19 +1364,19 @@ Ztring File__Analyze::Retrieve (stream_t StreamKind, size_t StreamPos, size_t Pa
     //Integrity
     if (StreamKind>=Stream_Max
      || StreamPos>=(*Stream)[StreamKind].size()
-     || Parameter>=MediaInfoLib::Config.Info_Get(StreamKind).size()+(*Stream_More)[StreamKind][StreamPos].size())
+     || Parameter>=Config_Info_Get(StreamKind).size()+(*Stream_More)[StreamKind][StreamPos].size())
         return MediaInfoLib::Config.EmptyString_Get();
 
-    if (Parameter>=MediaInfoLib::Config.Info_Get(StreamKind).size())
+    if (Parameter>=Config_Info_Get(StreamKind).size())
     {
-        Parameter-=MediaInfoLib::Config.Info_Get(StreamKind).size();
+        Parameter-=Config_Info_Get(StreamKind).size();
         if (KindOfInfo>=(*Stream_More)[StreamKind][StreamPos][Parameter].size())
             return MediaInfoLib::Config.EmptyString_Get();
         return (*Stream_More)[StreamKind][StreamPos][Parameter][KindOfInfo];
     }
 
     if (KindOfInfo!=Info_Text)
-        return MediaInfoLib::Config.Info_Get(StreamKind, Parameter, KindOfInfo);
+        return Config_Info_Get(StreamKind, Parameter, KindOfInfo);
 
     if (StreamKind>=(*Stream).size() || StreamPos>=(*Stream)[StreamKind].size() || Parameter>=(*Stream)[StreamKind][StreamPos].size())
         return MediaInfoLib::Config.EmptyString_Get();
@@ -1354,7 +1395,7 @@ const Ztring &File__Analyze::Retrieve_Const (stream_t StreamKind, size_t StreamP
     if (KindOfInfo!=Info_Text)
         return MediaInfoLib::Config.Info_Get(StreamKind, Parameter, KindOfInfo);
     const Ztring Parameter_Local = Ztring().From_UTF8(Parameter);
-    size_t Parameter_Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Parameter_Local);
+    size_t Parameter_Pos=Config_Info_Find(StreamKind, Parameter_Local);
     if (Parameter_Pos==Error)
     {
         if (StreamPos==(*Stream)[StreamKind].size())
@@ -1388,7 +1429,7 @@ Ztring File__Analyze::Retrieve (stream_t StreamKind, size_t StreamPos, const cha
     if (KindOfInfo!=Info_Text)
         return MediaInfoLib::Config.Info_Get(StreamKind, Parameter, KindOfInfo);
     const Ztring Parameter_Local = Ztring().From_UTF8(Parameter);
-    size_t Parameter_Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Parameter_Local);
+    size_t Parameter_Pos=Config_Info_Find(StreamKind, Parameter_Local);
     if (Parameter_Pos==Error)
     {
         Parameter_Pos=(*Stream_More)[StreamKind][StreamPos].Find(Parameter_Local);
@@ -1422,7 +1463,7 @@ void File__Analyze::Clear (stream_t StreamKind, size_t StreamPos, const char* Pa
         return;
     }
     const Ztring Parameter_Local = Ztring().From_UTF8(Parameter);
-    size_t Parameter_Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Parameter_Local);
+    size_t Parameter_Pos=Config_Info_Find(StreamKind, Parameter_Local);
     if (Parameter_Pos==Error)
     {
         Parameter_Pos=(*Stream_More)[StreamKind][StreamPos].Find(Parameter_Local);
@@ -1444,7 +1485,7 @@ void File__Analyze::Clear (stream_t StreamKind, size_t StreamPos, size_t Paramet
         return;
 
     //Normal
-    if (Parameter<MediaInfoLib::Config.Info_Get(StreamKind).size())
+    if (Parameter<Config_Info_Get(StreamKind).size())
     {
         //Is something available?
         if (Parameter>=(*Stream)[StreamKind][StreamPos].size())
@@ -1457,10 +1498,10 @@ void File__Analyze::Clear (stream_t StreamKind, size_t StreamPos, size_t Paramet
         if (MediaInfoLib::Config.ReadByHuman_Get())
         {
             //Strings
-            const Ztring &List_Measure_Value=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure);
+            const Ztring &List_Measure_Value=Config_Info_Get(StreamKind).Read(Parameter, Info_Measure);
                  if (List_Measure_Value==__T(" byte"))
             {
-                const Ztring &Temp=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Name);
+                const Ztring &Temp=Config_Info_Get(StreamKind).Read(Parameter, Info_Name);
                 size_t List_Size=Temp.find(__T("StreamSize"))==string::npos?5:7; //for /String5, with percentage, and proportion
                 for (size_t Pos=Parameter+1; Pos<=Parameter+List_Size; Pos++)
                     if (Pos<(*Stream)[StreamKind][StreamPos].size())
@@ -1487,7 +1528,7 @@ void File__Analyze::Clear (stream_t StreamKind, size_t StreamPos, size_t Paramet
                 if (Parameter+1<(*Stream)[StreamKind][StreamPos].size())
                     (*Stream)[StreamKind][StreamPos][Parameter+1].clear();
             }
-            else if (Parameter+1<(*Stream)[StreamKind][StreamPos].size() && MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter+1, Info_Name).find(__T("/String"))!=string::npos)
+            else if (Parameter+1<(*Stream)[StreamKind][StreamPos].size() && Config_Info_Get(StreamKind).Read(Parameter+1, Info_Name).find(__T("/String"))!=string::npos)
             {
                 (*Stream)[StreamKind][StreamPos][Parameter+1].clear();
             }
@@ -1697,7 +1738,7 @@ size_t File__Analyze::Merge(File__Analyze &ToAdd, stream_t StreamKind, size_t St
                     if (ToFill_Value==ToFill_FromContainer)
                     {
                         if (Retrieve_Const(StreamKind, StreamPos_To, Pos+1)!=ToAdd.Retrieve_Const(StreamKind, StreamPos_From, Pos+1))
-                            Fill(StreamKind, StreamPos_To, Pos+1, Retrieve_Const(StreamKind, StreamPos_To, Pos+1)+MediaInfoLib::Config.TagSeparator_Get()+ToAdd.Retrieve_Const(StreamKind, StreamPos_From, Pos+1), true);
+                            Fill(StreamKind, StreamPos_To, Pos+1, Retrieve_Const(StreamKind, StreamPos_To, Pos+1)+Config_TagSeparator+ToAdd.Retrieve_Const(StreamKind, StreamPos_From, Pos+1), true);
                     }
                     else
                     {
@@ -1718,7 +1759,7 @@ size_t File__Analyze::Merge(File__Analyze &ToAdd, stream_t StreamKind, size_t St
         }
         else if (!ToFill_Value.empty() && (Erase || Get(StreamKind, StreamPos_To, Pos).empty()))
         {
-            if (Pos<MediaInfoLib::Config.Info_Get(StreamKind).size())
+            if (Pos<Config_Info_Get(StreamKind).size())
                 Fill(StreamKind, StreamPos_To, Pos, ToFill_Value, true);
             else
             {
@@ -2507,7 +2548,7 @@ void File__Analyze::Kilo_Kilo123(stream_t StreamKind, size_t StreamPos, size_t P
             }
             if (!BitRateS.empty())
             {
-                Ztring Measure=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure);
+                Ztring Measure=Config_Info_Get(StreamKind).Read(Parameter, Info_Measure);
                 Measure.insert(1, __T("K"));
                 List2.push_back(MediaInfoLib::Config.Language_Get(BitRateS, Measure, true));
             }
@@ -2516,24 +2557,24 @@ void File__Analyze::Kilo_Kilo123(stream_t StreamKind, size_t StreamPos, size_t P
                 //Standard
                 if (BitRate>10000000000LL)
                 {
-                    Ztring Measure=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure);
+                    Ztring Measure=Config_Info_Get(StreamKind).Read(Parameter, Info_Measure);
                     Measure.insert(1, __T("G"));
                     List2.push_back(MediaInfoLib::Config.Language_Get(Ztring::ToZtring(((float)BitRate)/1000000000, BitRate>100000000000LL?0:1), Measure, true));
                 }
                 else if (BitRate>10000000)
                 {
-                    Ztring Measure=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure);
+                    Ztring Measure=Config_Info_Get(StreamKind).Read(Parameter, Info_Measure);
                     Measure.insert(1, __T("M"));
                     List2.push_back(MediaInfoLib::Config.Language_Get(Ztring::ToZtring(((float)BitRate)/1000000, BitRate>100000000?0:1), Measure, true));
                 }
                 else if (BitRate>10000)
                 {
-                    Ztring Measure=MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure);
+                    Ztring Measure=Config_Info_Get(StreamKind).Read(Parameter, Info_Measure);
                     Measure.insert(1, __T("K"));
                     List2.push_back(MediaInfoLib::Config.Language_Get(Ztring::ToZtring(((float)BitRate)/1000, BitRate>100000?0:1), Measure, true));
                 }
                 else
-                    List2.push_back(MediaInfoLib::Config.Language_Get(Ztring::ToZtring(BitRate), MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure), true));
+                    List2.push_back(MediaInfoLib::Config.Language_Get(Ztring::ToZtring(BitRate), Config_Info_Get(StreamKind).Read(Parameter, Info_Measure), true));
             }
         }
     }
@@ -2566,7 +2607,7 @@ void File__Analyze::Value_Value123(stream_t StreamKind, size_t StreamPos, size_t
     for (size_t Pos=0; Pos<List.size(); Pos++)
     {
         //Filling
-        List2.push_back(MediaInfoLib::Config.Language_Get(List[Pos], MediaInfoLib::Config.Info_Get(StreamKind).Read(Parameter, Info_Measure)));
+        List2.push_back(MediaInfoLib::Config.Language_Get(List[Pos], Config_Info_Get(StreamKind).Read(Parameter, Info_Measure)));
 
         //Special case : Audio Channels with ChannelMode
         if (StreamKind==Stream_Audio && Parameter==Audio_Channel_s_)
@@ -87,6 +87,10 @@ void File__Analyze::Streams_Finish_Global()
 
     TestDirectory();
 
+    //Memory budget
+    if (Config->File_Memory_Exceeded)
+        Fill(Stream_General, 0, "MaxMemory_Exceeded", "Yes");
+
     #if MEDIAINFO_ADVANCED
         if (MediaInfoLib::Config.ExternalMetaDataConfig_Get().empty()) // ExternalMetadata is used directly only if there is no ExternalMetadata config (=another format)
         {
@@ -195,7 +199,7 @@ void File__Analyze::Streams_Finish_Global()
             Extensions+=MediaInfoLib::Config.Format_Get(__T("E-AC-3"), InfoFormat_Extensions);
             Extensions+=__T(" eb3");
             Fill(Stream_General, 0, General_Format_Extensions, Extensions, true);
-            if (MediaInfoLib::Config.Legacy_Get())
+            if (Config_Legacy)
                 Fill(Stream_General, 0, General_Codec_Extensions, Extensions, true);
         }
     }
@@ -287,6 +291,7 @@ void File__Analyze::TestContinuousFileNames(size_t CountOfFiles, Ztring FileExte
                             Pos_Add_Max=TempPos+1;
                             break;
                         }
+                        Config->File_Dependency_Add(Next); //The sequence changes if it is created
                     }
                     if (Pos_Add_Max==Pos_Add_Max_Old)
                         break;
@@ -302,7 +307,12 @@ void File__Analyze::TestContinuousFileNames(size_t CountOfFiles, Ztring FileExte
                 Pos_Ztring.insert(0, Numbers_Size-Pos_Ztring.size(), __T('0'));
             Ztring Next=FileToTest_Name_Begin+Pos_Ztring+FileToTest_Name_End;
             if (!File::Exists(Next))
+            {
+                #if MEDIAINFO_ADVANCED
+                    Config->File_Dependency_Add(Next); //The sequence changes if it is created
+                #endif //MEDIAINFO_ADVANCED
                 break;
+            }
             Pos_Add_Max<<=1;
             #if MEDIAINFO_ADVANCED
                 if (File_IgnoreSequenceFileSize && Pos_Add_Max>=CountOfFiles)
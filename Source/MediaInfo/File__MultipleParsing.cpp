@@ -375,6 +375,8 @@
     #include "MediaInfo/File_Other.h"
 #endif
 #include "MediaInfo/File_Unknown.h"
+#include <algorithm>
+#include <cstring>
 //---------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------
@@ -382,6 +384,176 @@
 namespace MediaInfoLib
 {
 
+//***************************************************************************
+// Signatures
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+// Magic values and sync words, testing only the parsers matching the first
+// bytes instead of all parsers. Same order as in the list of all parsers.
+template<class T> static File__Analyze* MultipleParsing_New() {return new T;}
+#if defined(MEDIAINFO_BDAV_YES)
+    static File__Analyze* MultipleParsing_New_Bdav() {File_MpegTs* Temp=new File_MpegTs(); Temp->BDAV_Size=4; return Temp;}
+    static File__Analyze* MultipleParsing_New_Bdav_NoPatPmt() {File_MpegTs* Temp=new File_MpegTs(); Temp->BDAV_Size=4; Temp->NoPatPmt=true; return Temp;}
+#endif
+#if defined(MEDIAINFO_MPEGTS_YES)
+    static File__Analyze* MultipleParsing_New_MpegTs_NoPatPmt() {File_MpegTs* Temp=new File_MpegTs(); Temp->NoPatPmt=true; return Temp;}
+#endif
+#if defined(MEDIAINFO_TSP_YES)
+    static File__Analyze* MultipleParsing_New_Tsp() {File_MpegTs* Temp=new File_MpegTs(); Temp->TSP_Size=16; return Temp;}
+    static File__Analyze* MultipleParsing_New_Tsp_NoPatPmt() {File_MpegTs* Temp=new File_MpegTs(); Temp->TSP_Size=16; Temp->NoPatPmt=true; return Temp;}
+#endif
+#if defined(MEDIAINFO_AAC_YES)
+    static File__Analyze* MultipleParsing_New_Aac_Adif() {File_Aac* Temp=new File_Aac(); Temp->Mode=File_Aac::Mode_ADIF; return Temp;}
+    static File__Analyze* MultipleParsing_New_Aac_Adts() {File_Aac* Temp=new File_Aac(); Temp->Mode=File_Aac::Mode_ADTS; return Temp;}
+#endif
+
+struct multipleparsing_signature
+{
+    size_t          Offset;
+    size_t          Size;
+    const char*     Value;
+    size_t          Period; //If not 0, Value is also present at Offset+Period (sync word)
+    File__Analyze*  (*New)();
+};
+
+static const multipleparsing_signature MultipleParsing_Signatures[]=
+{
+    #if defined(MEDIAINFO_BDAV_YES)
+        {  4,  1, "\x47", 192, MultipleParsing_New_Bdav},
+        {  4,  1, "\x47", 192, MultipleParsing_New_Bdav_NoPatPmt},
+    #endif
+    #if defined(MEDIAINFO_FLV_YES)
+        {  0,  3, "FLV", 0, MultipleParsing_New<File_Flv>},
+    #endif
+    #if defined(MEDIAINFO_IVF_YES)
+        {  0,  4, "DKIF", 0, MultipleParsing_New<File_Ivf>},
+    #endif
+    #if defined(MEDIAINFO_MK_YES)
+        {  0,  4, "\x1A\x45\xDF\xA3", 0, MultipleParsing_New<File_Mk>},
+    #endif
+    #if defined(MEDIAINFO_MPEG4_YES)
+        {  4,  4, "ftyp", 0, MultipleParsing_New<File_Mpeg4>},
+        {  4,  4, "moov", 0, MultipleParsing_New<File_Mpeg4>},
+        {  4,  4, "mdat", 0, MultipleParsing_New<File_Mpeg4>},
+        {  4,  4, "free", 0, MultipleParsing_New<File_Mpeg4>},
+        {  4,  4, "skip", 0, MultipleParsing_New<File_Mpeg4>},
+        {  4,  4, "wide", 0, MultipleParsing_New<File_Mpeg4>},
+    #endif
+    #if defined(MEDIAINFO_MPEGPS_YES)
+        {  0,  4, "\x00\x00\x01\xBA", 0, MultipleParsing_New<File_MpegPs>},
+    #endif
+    #if defined(MEDIAINFO_MPEGTS_YES)
+        {  0,  1, "\x47", 188, MultipleParsing_New<File_MpegTs>},
+        {  0,  1, "\x47", 188, MultipleParsing_New_MpegTs_NoPatPmt},
+    #endif
+    #if defined(MEDIAINFO_TSP_YES)
+        {  0,  1, "\x47", 204, MultipleParsing_New_Tsp},
+        {  0,  1, "\x47", 204, MultipleParsing_New_Tsp_NoPatPmt},
+    #endif
+    #if defined(MEDIAINFO_MXF_YES)
+        {  0, 11, "\x06\x0E\x2B\x34\x02\x05\x01\x01\x0D\x01\x02", 0, MultipleParsing_New<File_Mxf>},
+    #endif
+    #if defined(MEDIAINFO_NUT_YES)
+        {  0,  8, "nut/mult", 0, MultipleParsing_New<File_Nut>},
+    #endif
+    #if defined(MEDIAINFO_OGG_YES)
+        {  0,  4, "OggS", 0, MultipleParsing_New<File_Ogg>},
+    #endif
+    #if defined(MEDIAINFO_RIFF_YES)
+        {  0,  4, "RIFF", 0, MultipleParsing_New<File_Riff>},
+        {  0,  4, "RF64", 0, MultipleParsing_New<File_Riff>},
+        {  0,  4, "FORM", 0, MultipleParsing_New<File_Riff>},
+    #endif
+    #if defined(MEDIAINFO_RM_YES)
+        {  0,  4, ".RMF", 0, MultipleParsing_New<File_Rm>},
+    #endif
+    #if defined(MEDIAINFO_WM_YES)
+        {  0,  8, "\x30\x26\xB2\x75\x8E\x66\xCF\x11", 0, MultipleParsing_New<File_Wm>},
+    #endif
+    #if defined(MEDIAINFO_Y4M_YES)
+        {  0,  9, "YUV4MPEG2", 0, MultipleParsing_New<File_Y4m>},
+    #endif
+    #if defined(MEDIAINFO_APE_YES)
+        {  0,  4, "MAC ", 0, MultipleParsing_New<File_Ape>},
+    #endif
+    #if defined(MEDIAINFO_AU_YES)
+        {  0,  4, ".snd", 0, MultipleParsing_New<File_Au>},
+    #endif
+    #if defined(MEDIAINFO_CAF_YES)
+        {  0,  4, "caff", 0, MultipleParsing_New<File_Caf>},
+    #endif
+    #if defined(MEDIAINFO_DSF_YES)
+        {  0,  4, "DSD ", 0, MultipleParsing_New<File_Dsf>},
+    #endif
+    #if defined(MEDIAINFO_DSDIFF_YES)
+        {  0,  4, "FRM8", 0, MultipleParsing_New<File_Dsdiff>},
+    #endif
+    #if defined(MEDIAINFO_FLAC_YES)
+        {  0,  4, "fLaC", 0, MultipleParsing_New<File_Flac>},
+    #endif
+    #if defined(MEDIAINFO_MIDI_YES)
+        {  0,  4, "MThd", 0, MultipleParsing_New<File_Midi>},
+    #endif
+    #if defined(MEDIAINFO_TAK_YES)
+        {  0,  4, "tBaK", 0, MultipleParsing_New<File_Tak>},
+    #endif
+    #if defined(MEDIAINFO_TTA_YES)
+        {  0,  4, "TTA1", 0, MultipleParsing_New<File_Tta>},
+    #endif
+    #if defined(MEDIAINFO_WVPK_YES)
+        {  0,  4, "wvpk", 0, MultipleParsing_New<File_Wvpk>},
+    #endif
+    #if defined(MEDIAINFO_PDF_YES)
+        {  0,  5, "%PDF-", 0, MultipleParsing_New<File_Pdf>},
+    #endif
+    #if defined(MEDIAINFO_BPG_YES)
+        {  0,  4, "BPG\xFB", 0, MultipleParsing_New<File_Bpg>},
+    #endif
+    #if defined(MEDIAINFO_DPX_YES)
+        {  0,  4, "SDPX", 0, MultipleParsing_New<File_Dpx>},
+        {  0,  4, "XPDS", 0, MultipleParsing_New<File_Dpx>},
+    #endif
+    #if defined(MEDIAINFO_EXR_YES)
+        {  0,  4, "\x76\x2F\x31\x01", 0, MultipleParsing_New<File_Exr>},
+    #endif
+    #if defined(MEDIAINFO_GIF_YES)
+        {  0,  4, "GIF8", 0, MultipleParsing_New<File_Gif>},
+    #endif
+    #if defined(MEDIAINFO_JPEG_YES)
+        {  0,  3, "\xFF\xD8\xFF", 0, MultipleParsing_New<File_Jpeg>},
+    #endif
+    #if defined(MEDIAINFO_PNG_YES)
+        {  0,  8, "\x89PNG\x0D\x0A\x1A\x0A", 0, MultipleParsing_New<File_Png>},
+    #endif
+    #if defined(MEDIAINFO_PSD_YES)
+        {  0,  4, "8BPS", 0, MultipleParsing_New<File_Psd>},
+    #endif
+    #if defined(MEDIAINFO_TIFF_YES)
+        {  0,  4, "II\x2A\x00", 0, MultipleParsing_New<File_Tiff>},
+        {  0,  4, "MM\x00\x2A", 0, MultipleParsing_New<File_Tiff>},
+    #endif
+    #if defined(MEDIAINFO_7Z_YES)
+        {  0,  6, "7z\xBC\xAF\x27\x1C", 0, MultipleParsing_New<File_7z>},
+    #endif
+    #if defined(MEDIAINFO_BZIP2_YES)
+        {  0,  3, "BZh", 0, MultipleParsing_New<File_Bzip2>},
+    #endif
+    #if defined(MEDIAINFO_ELF_YES)
+        {  0,  4, "\x7F" "ELF", 0, MultipleParsing_New<File_Elf>},
+    #endif
+    #if defined(MEDIAINFO_GZIP_YES)
+        {  0,  2, "\x1F\x8B", 0, MultipleParsing_New<File_Gzip>},
+    #endif
+    #if defined(MEDIAINFO_RAR_YES)
+        {  0,  7, "Rar!\x1A\x07\x00", 0, MultipleParsing_New<File_Rar>},
+    #endif
+    #if defined(MEDIAINFO_ZIP_YES)
+        {  0,  4, "PK\x03\x04", 0, MultipleParsing_New<File_Zip>},
+    #endif
+    {  0,  0, NULL, 0, NULL}, //End
+};
+
 //***************************************************************************
 // Out
 //***************************************************************************
@@ -409,373 +581,440 @@ File__MultipleParsing::File__MultipleParsing()
         Trace_DoNotSave=true;
     #endif //MEDIAINFO_TRACE
 
+    //Temp
+    Parser_IsCreated=false;
+    Parser_IsProbing=false;
+}
+
+//---------------------------------------------------------------------------
+File__MultipleParsing::~File__MultipleParsing()
+{
+    for (size_t Pos=0; Pos<Parser.size(); Pos++)
+        delete Parser[Pos]; //Parser[Pos]=NULL
+}
+
+//***************************************************************************
+// Parsers
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+bool File__MultipleParsing::Parser_Add_FromSignatures()
+{
+    for (const multipleparsing_signature* Signature=MultipleParsing_Signatures; Signature->Value; Signature++)
+    {
+        size_t Offset=Signature->Offset;
+        size_t Count=Signature->Period?3:1;
+        for (; Count; Count--)
+        {
+            if (Offset+Signature->Size>Buffer_Size || memcmp(Buffer+Offset, Signature->Value, Signature->Size))
+                break;
+            Offset+=Signature->Period;
+        }
+        if (Count)
+            continue;
+        if (std::find(Probe_News.begin(), Probe_News.end(), Signature->New)==Probe_News.end())
+        {
+            Probe_News.push_back(Signature->New);
+            Probe_Parsers.push_back(Signature->New());
+        }
+    }
+
+    Parser=Probe_Parsers;
+    return !Parser.empty();
+}
+
+//---------------------------------------------------------------------------
+void File__MultipleParsing::Parser_Add(parser_new New)
+{
+    //Parsers already tested with the first bytes
+    for (size_t Pos=0; Pos<Probe_News.size(); Pos++)
+        if (Probe_News[Pos]==New)
+        {
+            if (Probe_Parsers[Pos])
+                Parser.push_back(Probe_Parsers[Pos]); //Not yet decided, kept at its place in the list
+            return; //Rejected, not tested again
+        }
+
+    File__Analyze* Temp=New();
+    Parser_Init(Temp);
+    Parser.push_back(Temp);
+}
+
+//---------------------------------------------------------------------------
+void File__MultipleParsing::Parser_Init(File__Analyze* Temp)
+{
+    #if MEDIAINFO_TRACE
+        Temp->Init(Config, Details, Stream, Stream_More);
+    #else //MEDIAINFO_TRACE
+        Temp->Init(Config, Stream, Stream_More);
+    #endif //MEDIAINFO_TRACE
+    Temp->File_Name=File_Name;
+    Temp->Open_Buffer_Init(File_Size);
+}
+
+//---------------------------------------------------------------------------
+void File__MultipleParsing::Parser_Add_All()
+{
     // Multiple
     #if defined(MEDIAINFO_AAF_YES)
-        Parser.push_back(new File_Aaf());
+        Parser_Add(MultipleParsing_New<File_Aaf>);
     #endif
     #if defined(MEDIAINFO_BDAV_YES)
-        {File_MpegTs* Temp=new File_MpegTs(); Temp->BDAV_Size=4; Parser.push_back(Temp);}
-        {File_MpegTs* Temp=new File_MpegTs(); Temp->BDAV_Size=4; Temp->NoPatPmt=true; Parser.push_back(Temp);}
+        Parser_Add(MultipleParsing_New_Bdav);
+        Parser_Add(MultipleParsing_New_Bdav_NoPatPmt);
     #endif
 //    Only with directories, no By Buffer interface
 //    #if defined(MEDIAINFO_BDMV_YES)
-//        Parser.push_back(new File_Bdmv());
+//        Parser_Add(MultipleParsing_New<File_Bdmv>);
 //    #endif
     #if defined(MEDIAINFO_CDXA_YES)
-        Parser.push_back(new File_Cdxa());
+        Parser_Add(MultipleParsing_New<File_Cdxa>);
     #endif
     #if defined(MEDIAINFO_DASHMPD_YES)
-        Parser.push_back(new File_DashMpd());
+        Parser_Add(MultipleParsing_New<File_DashMpd>);
     #endif
     #if defined(MEDIAINFO_DCP_YES)
-        Parser.push_back(new File_DcpAm());
+        Parser_Add(MultipleParsing_New<File_DcpAm>);
     #endif
     #if defined(MEDIAINFO_DCP_YES)
-        Parser.push_back(new File_DcpCpl());
+        Parser_Add(MultipleParsing_New<File_DcpCpl>);
     #endif
     #if defined(MEDIAINFO_DCP_YES)
-        Parser.push_back(new File_DcpPkl());
+        Parser_Add(MultipleParsing_New<File_DcpPkl>);
     #endif
     #if defined(MEDIAINFO_DPG_YES)
-        Parser.push_back(new File_Dpg());
+        Parser_Add(MultipleParsing_New<File_Dpg>);
     #endif
     #if defined(MEDIAINFO_DVDIF_YES)
-        Parser.push_back(new File_DvDif());
+        Parser_Add(MultipleParsing_New<File_DvDif>);
     #endif
     #if defined(MEDIAINFO_DVDV_YES)
-        Parser.push_back(new File_Dvdv());
+        Parser_Add(MultipleParsing_New<File_Dvdv>);
     #endif
     #if defined(MEDIAINFO_DXW_YES)
-        Parser.push_back(new File_Dxw());
+        Parser_Add(MultipleParsing_New<File_Dxw>);
     #endif
     #if defined(MEDIAINFO_FLV_YES)
-        Parser.push_back(new File_Flv());
+        Parser_Add(MultipleParsing_New<File_Flv>);
     #endif
     #if defined(MEDIAINFO_GXF_YES)
-        Parser.push_back(new File_Gxf());
+        Parser_Add(MultipleParsing_New<File_Gxf>);
     #endif
     #if defined(MEDIAINFO_HDSF4M_YES)
-        Parser.push_back(new File_HdsF4m());
+        Parser_Add(MultipleParsing_New<File_HdsF4m>);
     #endif
     #if defined(MEDIAINFO_HLS_YES)
-        Parser.push_back(new File_Hls());
+        Parser_Add(MultipleParsing_New<File_Hls>);
     #endif
     #if defined(MEDIAINFO_ISM_YES)
-        Parser.push_back(new File_Ism());
+        Parser_Add(MultipleParsing_New<File_Ism>);
     #endif
     #if defined(MEDIAINFO_IVF_YES)
-        Parser.push_back(new File_Ivf());
+        Parser_Add(MultipleParsing_New<File_Ivf>);
     #endif
     #if defined(MEDIAINFO_LXF_YES)
-        Parser.push_back(new File_Lxf());
+        Parser_Add(MultipleParsing_New<File_Lxf>);
     #endif
     #if defined(MEDIAINFO_MK_YES)
-        Parser.push_back(new File_Mk());
+        Parser_Add(MultipleParsing_New<File_Mk>);
     #endif
     #if defined(MEDIAINFO_MIXML_YES)
-        Parser.push_back(new File_MiXml());
+        Parser_Add(MultipleParsing_New<File_MiXml>);
     #endif
     #if defined(MEDIAINFO_MPEG4_YES)
-        Parser.push_back(new File_Mpeg4());
+        Parser_Add(MultipleParsing_New<File_Mpeg4>);
     #endif
     #if defined(MEDIAINFO_MPEGPS_YES)
-        Parser.push_back(new File_MpegPs());
+        Parser_Add(MultipleParsing_New<File_MpegPs>);
     #endif
     #if defined(MEDIAINFO_MPEGTS_YES)
-        Parser.push_back(new File_MpegTs());
-        {File_MpegTs* Temp=new File_MpegTs(); Temp->NoPatPmt=true; Parser.push_back(Temp);}
+        Parser_Add(MultipleParsing_New<File_MpegTs>);
+        Parser_Add(MultipleParsing_New_MpegTs_NoPatPmt);
     #endif
     #if defined(MEDIAINFO_TSP_YES)
-        {File_MpegTs* Temp=new File_MpegTs(); Temp->TSP_Size=16; Parser.push_back(Temp);}
-        {File_MpegTs* Temp=new File_MpegTs(); Temp->TSP_Size=16; Temp->NoPatPmt=true; Parser.push_back(Temp);}
+        Parser_Add(MultipleParsing_New_Tsp);
+        Parser_Add(MultipleParsing_New_Tsp_NoPatPmt);
     #endif
     #if defined(MEDIAINFO_MXF_YES)
-        Parser.push_back(new File_Mxf());
+        Parser_Add(MultipleParsing_New<File_Mxf>);
     #endif
     #if defined(MEDIAINFO_NUT_YES)
-        Parser.push_back(new File_Nut());
+        Parser_Add(MultipleParsing_New<File_Nut>);
     #endif
     #if defined(MEDIAINFO_OGG_YES)
-        Parser.push_back(new File_Ogg());
+        Parser_Add(MultipleParsing_New<File_Ogg>);
     #endif
     #if defined(MEDIAINFO_P2_YES)
-        Parser.push_back(new File_P2_Clip());
+        Parser_Add(MultipleParsing_New<File_P2_Clip>);
     #endif
     #if defined(MEDIAINFO_PMP_YES)
-        Parser.push_back(new File_Pmp());
+        Parser_Add(MultipleParsing_New<File_Pmp>);
     #endif
     #if defined(MEDIAINFO_PTX_YES)
-        Parser.push_back(new File_Ptx());
+        Parser_Add(MultipleParsing_New<File_Ptx>);
     #endif
     #if defined(MEDIAINFO_RIFF_YES)
-        Parser.push_back(new File_Riff());
+        Parser_Add(MultipleParsing_New<File_Riff>);
     #endif
     #if defined(MEDIAINFO_RM_YES)
-        Parser.push_back(new File_Rm());
+        Parser_Add(MultipleParsing_New<File_Rm>);
     #endif
     #if defined(MEDIAINFO_SEQUENCEINFO_YES)
-        Parser.push_back(new File_SequenceInfo());
+        Parser_Add(MultipleParsing_New<File_SequenceInfo>);
     #endif
     #if defined(MEDIAINFO_SKM_YES)
-        Parser.push_back(new File_Skm());
+        Parser_Add(MultipleParsing_New<File_Skm>);
     #endif
     #if defined(MEDIAINFO_SWF_YES)
-        Parser.push_back(new File_Swf());
+        Parser_Add(MultipleParsing_New<File_Swf>);
     #endif
     #if defined(MEDIAINFO_WM_YES)
-        Parser.push_back(new File_Wm());
+        Parser_Add(MultipleParsing_New<File_Wm>);
     #endif
     #if defined(MEDIAINFO_WTV_YES)
-        Parser.push_back(new File_Wtv());
+        Parser_Add(MultipleParsing_New<File_Wtv>);
     #endif
     #if defined(MEDIAINFO_XDCAM_YES)
-        Parser.push_back(new File_Xdcam_Clip());
+        Parser_Add(MultipleParsing_New<File_Xdcam_Clip>);
     #endif
 
     // Video
     #if defined(MEDIAINFO_AVC_YES)
-        Parser.push_back(new File_Avc());
+        Parser_Add(MultipleParsing_New<File_Avc>);
     #endif
     #if defined(MEDIAINFO_HEVC_YES)
-        Parser.push_back(new File_Hevc());
+        Parser_Add(MultipleParsing_New<File_Hevc>);
     #endif
     #if defined(MEDIAINFO_AVSV_YES)
-        Parser.push_back(new File_AvsV());
+        Parser_Add(MultipleParsing_New<File_AvsV>);
     #endif
     #if defined(MEDIAINFO_DIRAC_YES)
-        Parser.push_back(new File_Dirac());
+        Parser_Add(MultipleParsing_New<File_Dirac>);
     #endif
     #if defined(MEDIAINFO_FLIC_YES)
-        Parser.push_back(new File_Flic());
+        Parser_Add(MultipleParsing_New<File_Flic>);
     #endif
     #if defined(MEDIAINFO_H263_YES)
-        Parser.push_back(new File_H263());
+        Parser_Add(MultipleParsing_New<File_H263>);
     #endif
     #if defined(MEDIAINFO_MPEG4V_YES)
-        Parser.push_back(new File_Mpeg4v());
+        Parser_Add(MultipleParsing_New<File_Mpeg4v>);
     #endif
     #if defined(MEDIAINFO_MPEGV_YES)
-        Parser.push_back(new File_Mpegv());
+        Parser_Add(MultipleParsing_New<File_Mpegv>);
     #endif
     #if defined(MEDIAINFO_VC1_YES)
-        Parser.push_back(new File_Vc1());
+        Parser_Add(MultipleParsing_New<File_Vc1>);
     #endif
     #if defined(MEDIAINFO_VC3_YES)
-        Parser.push_back(new File_Vc3());
+        Parser_Add(MultipleParsing_New<File_Vc3>);
     #endif
     #if defined(MEDIAINFO_Y4M_YES)
-        Parser.push_back(new File_Y4m());
+        Parser_Add(MultipleParsing_New<File_Y4m>);
     #endif
 
     // Audio
     #if defined(MEDIAINFO_AAC_YES)
-        {File_Aac* Temp=new File_Aac(); Temp->Mode=File_Aac::Mode_ADIF; Parser.push_back(Temp);}
+        Parser_Add(MultipleParsing_New_Aac_Adif);
     #endif
     #if defined(MEDIAINFO_AAC_YES)
-        {File_Aac* Temp=new File_Aac(); Temp->Mode=File_Aac::Mode_ADTS; Parser.push_back(Temp);}
+        Parser_Add(MultipleParsing_New_Aac_Adts);
     #endif
     #if defined(MEDIAINFO_AC3_YES)
-        Parser.push_back(new File_Ac3());
+        Parser_Add(MultipleParsing_New<File_Ac3>);
     #endif
     #if defined(MEDIAINFO_AC3_YES)
-        Parser.push_back(new File_Ac4());
+        Parser_Add(MultipleParsing_New<File_Ac4>);
     #endif
     #if defined(MEDIAINFO_SMPTEST0337_YES)
-        Parser.push_back(new File_SmpteSt0337());
+        Parser_Add(MultipleParsing_New<File_SmpteSt0337>);
     #endif
     #if defined(MEDIAINFO_ALS_YES)
-        Parser.push_back(new File_Als());
+        Parser_Add(MultipleParsing_New<File_Als>);
     #endif
     #if defined(MEDIAINFO_AMR_YES)
-        Parser.push_back(new File_Amr());
+        Parser_Add(MultipleParsing_New<File_Amr>);
     #endif
     #if defined(MEDIAINFO_AMV_YES)
-        Parser.push_back(new File_Amv());
+        Parser_Add(MultipleParsing_New<File_Amv>);
     #endif
     #if defined(MEDIAINFO_APE_YES)
-        Parser.push_back(new File_Ape());
+        Parser_Add(MultipleParsing_New<File_Ape>);
     #endif
     #if defined(MEDIAINFO_AU_YES)
-        Parser.push_back(new File_Au());
+        Parser_Add(MultipleParsing_New<File_Au>);
     #endif
     #if defined(MEDIAINFO_CAF_YES)
-        Parser.push_back(new File_Caf());
+        Parser_Add(MultipleParsing_New<File_Caf>);
     #endif
     #if defined(MEDIAINFO_DSF_YES)
-        Parser.push_back(new File_Dsf());
+        Parser_Add(MultipleParsing_New<File_Dsf>);
     #endif
     #if defined(MEDIAINFO_DSDIFF_YES)
-        Parser.push_back(new File_Dsdiff());
+        Parser_Add(MultipleParsing_New<File_Dsdiff>);
     #endif
     #if defined(MEDIAINFO_DTS_YES)
-        Parser.push_back(new File_Dts());
+        Parser_Add(MultipleParsing_New<File_Dts>);
     #endif
 //    Too many false-positives
 //    #if defined(MEDIAINFO_DOLBYE_YES)
-//        Parser.push_back(new File_DolbyE());
+//        Parser_Add(MultipleParsing_New<File_DolbyE>);
 //    #endif
     #if defined(MEDIAINFO_FLAC_YES)
-        Parser.push_back(new File_Flac());
+        Parser_Add(MultipleParsing_New<File_Flac>);
     #endif
     #if defined(MEDIAINFO_IT_YES)
-        Parser.push_back(new File_ImpulseTracker());
+        Parser_Add(MultipleParsing_New<File_ImpulseTracker>);
     #endif
     #if defined(MEDIAINFO_LA_YES)
-        Parser.push_back(new File_La());
+        Parser_Add(MultipleParsing_New<File_La>);
     #endif
     #if defined(MEDIAINFO_MIDI_YES)
-        Parser.push_back(new File_Midi());
+        Parser_Add(MultipleParsing_New<File_Midi>);
     #endif
     #if defined(MEDIAINFO_MOD_YES)
-        Parser.push_back(new File_Module());
+        Parser_Add(MultipleParsing_New<File_Module>);
     #endif
     #if defined(MEDIAINFO_MPC_YES)
-        Parser.push_back(new File_Mpc());
+        Parser_Add(MultipleParsing_New<File_Mpc>);
     #endif
     #if defined(MEDIAINFO_MPCSV8_YES)
-        Parser.push_back(new File_MpcSv8());
+        Parser_Add(MultipleParsing_New<File_MpcSv8>);
     #endif
     #if defined(MEDIAINFO_MPEGA_YES)
-        Parser.push_back(new File_Mpega());
+        Parser_Add(MultipleParsing_New<File_Mpega>);
     #endif
     #if defined(MEDIAINFO_OPENMG_YES)
-        Parser.push_back(new File_OpenMG());
+        Parser_Add(MultipleParsing_New<File_OpenMG>);
     #endif
     #if defined(MEDIAINFO_RKAU_YES)
-        Parser.push_back(new File_Rkau());
+        Parser_Add(MultipleParsing_New<File_Rkau>);
     #endif
     #if defined(MEDIAINFO_S3M_YES)
-        Parser.push_back(new File_ScreamTracker3());
+        Parser_Add(MultipleParsing_New<File_ScreamTracker3>);
     #endif
     #if defined(MEDIAINFO_TAK_YES)
-        Parser.push_back(new File_Tak());
+        Parser_Add(MultipleParsing_New<File_Tak>);
     #endif
     #if defined(MEDIAINFO_TTA_YES)
-        Parser.push_back(new File_Tta());
+        Parser_Add(MultipleParsing_New<File_Tta>);
     #endif
     #if defined(MEDIAINFO_TWINVQ_YES)
-        Parser.push_back(new File_TwinVQ());
+        Parser_Add(MultipleParsing_New<File_TwinVQ>);
     #endif
     #if defined(MEDIAINFO_WVPK_YES)
-        Parser.push_back(new File_Wvpk());
+        Parser_Add(MultipleParsing_New<File_Wvpk>);
     #endif
     #if defined(MEDIAINFO_XM_YES)
-        Parser.push_back(new File_ExtendedModule());
+        Parser_Add(MultipleParsing_New<File_ExtendedModule>);
     #endif
 
     // Text
 //    Too many false-positives
 //    #if defined(MEDIAINFO_EIA608_YES)
-//        Parser.push_back(new File_Eia608());
+//        Parser_Add(MultipleParsing_New<File_Eia608>);
 //    #endif
     #if defined(MEDIAINFO_N19_YES)
-        Parser.push_back(new File_N19());
+        Parser_Add(MultipleParsing_New<File_N19>);
     #endif
     #if defined(MEDIAINFO_PDF_YES)
-        Parser.push_back(new File_Pdf());
+        Parser_Add(MultipleParsing_New<File_Pdf>);
     #endif
     #if defined(MEDIAINFO_SCC_YES)
-        Parser.push_back(new File_Scc());
+        Parser_Add(MultipleParsing_New<File_Scc>);
     #endif
     #if defined(MEDIAINFO_SUBRIP_YES)
-        Parser.push_back(new File_SubRip());
+        Parser_Add(MultipleParsing_New<File_SubRip>);
     #endif
     #if defined(MEDIAINFO_TTML_YES)
-        Parser.push_back(new File_Ttml());
+        Parser_Add(MultipleParsing_New<File_Ttml>);
     #endif
     #if defined(MEDIAINFO_OTHERTEXT_YES)
-        Parser.push_back(new File_OtherText());
+        Parser_Add(MultipleParsing_New<File_OtherText>);
     #endif
 
     // Image
     #if defined(MEDIAINFO_ARRIRAW_YES)
-        Parser.push_back(new File_ArriRaw());
+        Parser_Add(MultipleParsing_New<File_ArriRaw>);
     #endif
     #if defined(MEDIAINFO_BMP_YES)
-        Parser.push_back(new File_Bmp());
+        Parser_Add(MultipleParsing_New<File_Bmp>);
     #endif
     #if defined(MEDIAINFO_BPG_YES)
-        Parser.push_back(new File_Bpg());
+        Parser_Add(MultipleParsing_New<File_Bpg>);
     #endif
     #if defined(MEDIAINFO_DDS_YES)
-        Parser.push_back(new File_Dds());
+        Parser_Add(MultipleParsing_New<File_Dds>);
     #endif
     #if defined(MEDIAINFO_DPX_YES)
-        Parser.push_back(new File_Dpx());
+        Parser_Add(MultipleParsing_New<File_Dpx>);
     #endif
     #if defined(MEDIAINFO_EXR_YES)
-        Parser.push_back(new File_Exr());
+        Parser_Add(MultipleParsing_New<File_Exr>);
     #endif
     #if defined(MEDIAINFO_GIF_YES)
-        Parser.push_back(new File_Gif());
+        Parser_Add(MultipleParsing_New<File_Gif>);
     #endif
     #if defined(MEDIAINFO_ICO_YES)
-        Parser.push_back(new File_Ico());
+        Parser_Add(MultipleParsing_New<File_Ico>);
     #endif
     #if defined(MEDIAINFO_JPEG_YES)
-        Parser.push_back(new File_Jpeg());
+        Parser_Add(MultipleParsing_New<File_Jpeg>);
     #endif
     #if defined(MEDIAINFO_PCX_YES)
-        Parser.push_back(new File_Pcx());
+        Parser_Add(MultipleParsing_New<File_Pcx>);
     #endif
     #if defined(MEDIAINFO_PNG_YES)
-        Parser.push_back(new File_Png());
+        Parser_Add(MultipleParsing_New<File_Png>);
     #endif
     #if defined(MEDIAINFO_PSD_YES)
-        Parser.push_back(new File_Psd());
+        Parser_Add(MultipleParsing_New<File_Psd>);
     #endif
     #if defined(MEDIAINFO_TIFF_YES)
-        Parser.push_back(new File_Tiff());
+        Parser_Add(MultipleParsing_New<File_Tiff>);
     #endif
     #if defined(MEDIAINFO_TGA_YES)
-        Parser.push_back(new File_Tga());
+        Parser_Add(MultipleParsing_New<File_Tga>);
     #endif
 
     // Archive
     #if defined(MEDIAINFO_7Z_YES)
-        Parser.push_back(new File_7z());
+        Parser_Add(MultipleParsing_New<File_7z>);
     #endif
     #if defined(MEDIAINFO_ACE_YES)
-        Parser.push_back(new File_Ace());
+        Parser_Add(MultipleParsing_New<File_Ace>);
     #endif
     #if defined(MEDIAINFO_BZIP2_YES)
-        Parser.push_back(new File_Bzip2());
+        Parser_Add(MultipleParsing_New<File_Bzip2>);
     #endif
     #if defined(MEDIAINFO_ELF_YES)
-        Parser.push_back(new File_Elf());
+        Parser_Add(MultipleParsing_New<File_Elf>);
     #endif
     #if defined(MEDIAINFO_GZIP_YES)
-        Parser.push_back(new File_Gzip());
+        Parser_Add(MultipleParsing_New<File_Gzip>);
     #endif
     #if defined(MEDIAINFO_ISO9660_YES)
-        Parser.push_back(new File_Iso9660());
+        Parser_Add(MultipleParsing_New<File_Iso9660>);
     #endif
     #if defined(MEDIAINFO_MZ_YES)
-        Parser.push_back(new File_Mz());
+        Parser_Add(MultipleParsing_New<File_Mz>);
     #endif
     #if defined(MEDIAINFO_RAR_YES)
-        Parser.push_back(new File_Rar());
+        Parser_Add(MultipleParsing_New<File_Rar>);
     #endif
     #if defined(MEDIAINFO_TAR_YES)
-        Parser.push_back(new File_Tar());
+        Parser_Add(MultipleParsing_New<File_Tar>);
     #endif
     #if defined(MEDIAINFO_ZIP_YES)
-        Parser.push_back(new File_Zip());
+        Parser_Add(MultipleParsing_New<File_Zip>);
     #endif
 
     // Other
     #if defined(MEDIAINFO_OTHER_YES)
-        Parser.push_back(new File_Other());
+        Parser_Add(MultipleParsing_New<File_Other>);
     #endif
 }
 
-//---------------------------------------------------------------------------
-File__MultipleParsing::~File__MultipleParsing()
-{
-    for (size_t Pos=0; Pos<Parser.size(); Pos++)
-        delete Parser[Pos]; //Parser[Pos]=NULL
-}
-
 //***************************************************************************
 // Streams management
 //***************************************************************************
@@ -801,16 +1040,7 @@ void File__MultipleParsing::Read_Buffer_Init()
 {
     //Parsing
     for (size_t Pos=0; Pos<Parser.size(); Pos++)
-    {
-        //Parsing
-        #if MEDIAINFO_TRACE
-            Parser[Pos]->Init(Config, Details, Stream, Stream_More);
-        #else //MEDIAINFO_TRACE
-            Parser[Pos]->Init(Config, Stream, Stream_More);
-        #endif //MEDIAINFO_TRACE
-        Parser[Pos]->File_Name=File_Name;
-        Parser[Pos]->Open_Buffer_Init(File_Size);
-    }
+        Parser_Init(Parser[Pos]);
 }
 
 //---------------------------------------------------------------------------
@@ -824,13 +1054,63 @@ void File__MultipleParsing::Read_Buffer_Unsynched()
 //---------------------------------------------------------------------------
 void File__MultipleParsing::Read_Buffer_Continue()
 {
+    //Parsers creation
+    if (!Parser_IsCreated)
+    {
+        Parser_IsCreated=true;
+
+        //Trying only the parsers matching the first bytes
+        if (Parser_Add_FromSignatures())
+        {
+            //Side effects of the candidates are rolled back if they are not conclusive
+            std::bitset<32> Status_Save=Status;
+            std::vector<std::vector<ZtringList> > Stream_Save=*Stream;
+            std::vector<std::vector<ZtringListList> > Stream_More_Save=*Stream_More;
+            #if MEDIAINFO_TRACE
+                string Details_Save;
+                if (Details)
+                    Details_Save=*Details;
+            #endif //MEDIAINFO_TRACE
+
+            Parser_IsProbing=true;
+            Read_Buffer_Init();
+            Read_Buffer_Continue();
+            Parser_IsProbing=false;
+            if (Parser.size()==1 && Parser[0]->Status[IsAccepted])
+            {
+                Probe_News.clear();
+                Probe_Parsers.clear();
+                return;
+            }
+
+            //Not conclusive, the candidates not yet decided continue with the other parsers
+            for (size_t Pos=0; Pos<Probe_Parsers.size(); Pos++)
+                if (std::find(Parser.begin(), Parser.end(), Probe_Parsers[Pos])==Parser.end())
+                    Probe_Parsers[Pos]=NULL; //Rejected and deleted
+            Parser.clear();
+            Status=Status_Save;
+            *Stream=Stream_Save;
+            *Stream_More=Stream_More_Save;
+            #if MEDIAINFO_TRACE
+                if (Details)
+                    *Details=Details_Save;
+            #endif //MEDIAINFO_TRACE
+            File_GoTo=(int64u)-1;
+        }
+
+        Parser_Add_All(); //New parsers are initialized when added
+    }
+
     //Parsing
     for (size_t Pos=0; Pos<Parser.size(); Pos++)
     {
-        //Parsing
-        Parser[Pos]->Open_Buffer_Continue(Buffer+Buffer_Offset, (size_t)Element_Size);
-        if (File_Offset+Buffer_Size==File_Size)
-            Parser[Pos]->Open_Buffer_Finalize();
+        //Parsing, except the candidates which already have this buffer
+        if (Parser_IsProbing || Probe_Parsers.empty() || std::find(Probe_Parsers.begin(), Probe_Parsers.end(), Parser[Pos])==Probe_Parsers.end())
+        {
+            Parser[Pos]->Open_Buffer_Continue(Buffer+Buffer_Offset, (size_t)Element_Size);
+            if (File_Offset+Buffer_Size==File_Size)
+                Parser[Pos]->Open_Buffer_Finalize();
+        }
 
         //Testing if the parser failed
         if (Parser[Pos]->Status[IsFinished] && !Parser[Pos]->Status[IsAccepted])
@@ -839,8 +1119,9 @@ void File__MultipleParsing::Read_Buffer_Continue()
             Parser.erase(Parser.begin()+Pos);
             Pos--; //for the next position
 
-            if (Parser.empty())
+            if (Parser.empty() && !Parser_IsProbing)
             {
+                Probe_Parsers.clear(); //The new parser may have the address of a deleted candidate
                 File__Analyze* Temp=new File_Unknown(); Parser.push_back(Temp);
                 Read_Buffer_Init();
             }
@@ -859,7 +1140,7 @@ void File__MultipleParsing::Read_Buffer_Continue()
                 Pos=0;
             }
 
-            if (Parser.size()==1)
+            if (Parser.size()==1 && (!Parser_IsProbing || Parser[Pos]->Status[IsAccepted]))
             {
                 //Status
                 if (!Status[IsAccepted] && Parser[Pos]->Status[IsAccepted])
@@ -882,6 +1163,13 @@ void File__MultipleParsing::Read_Buffer_Continue()
             }
         }
     }
+
+    //All parsers have now the same buffers
+    if (!Parser_IsProbing)
+    {
+        Probe_News.clear();
+        Probe_Parsers.clear();
+    }
 }
 
 } //NameSpace
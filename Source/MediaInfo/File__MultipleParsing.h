@@ -45,8 +45,19 @@ private :
     void Read_Buffer_Unsynched();
     void Read_Buffer_Continue();
 
+    //Parsers
+    typedef File__Analyze* (*parser_new)();
+    bool Parser_Add_FromSignatures();
+    void Parser_Add_All();
+    void Parser_Add(parser_new New);
+    void Parser_Init(File__Analyze* Temp);
+
     //Temp
     std::vector<File__Analyze*> Parser;
+    std::vector<parser_new>     Probe_News;    //Parsers tested with the first bytes
+    std::vector<File__Analyze*> Probe_Parsers; //Same order as Probe_News, NULL if rejected
+    bool Parser_IsCreated;
+    bool Parser_IsProbing;
 };
 
 } //NameSpace
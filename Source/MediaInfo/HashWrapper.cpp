@@ -24,6 +24,11 @@
 
 //---------------------------------------------------------------------------
 #include "ZenLib/Ztring.h"
+#include "ZenLib/Thread.h"
+#include "ZenLib/CriticalSection.h"
+#include "MediaInfo/Condition.h"
+#include <vector>
+#include <cstring>
 using namespace ZenLib;
 #if MEDIAINFO_MD5
     extern "C"
@@ -54,19 +59,142 @@ namespace MediaInfoLib
 
 static const char HashWrapper_Hex[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
 
+//---------------------------------------------------------------------------
+static void HashWrapper_Update (void** m, size_t Function, const int8u* Buffer, const size_t Buffer_Size)
+{
+    switch (Function)
+    {
+        #if MEDIAINFO_MD5
+        case HashWrapper::MD5:
+            MD5Update((struct MD5Context*)m[Function], Buffer, (unsigned int)Buffer_Size);
+            break;
+        #endif //MEDIAINFO_MD5
+        #if MEDIAINFO_SHA1
+        case HashWrapper::SHA1:
+            sha1_hash(Buffer, (unsigned long)Buffer_Size, (sha1_ctx*)m[Function]);
+            break;
+        #endif //MEDIAINFO_SHA1
+        #if MEDIAINFO_SHA2
+        case HashWrapper::SHA224:
+            sha224_hash(Buffer, (unsigned long)Buffer_Size, (sha224_ctx*)m[Function]);
+            break;
+        case HashWrapper::SHA256:
+            sha256_hash(Buffer, (unsigned long)Buffer_Size, (sha256_ctx*)m[Function]);
+            break;
+        case HashWrapper::SHA384:
+            sha384_hash(Buffer, (unsigned long)Buffer_Size, (sha384_ctx*)m[Function]);
+            break;
+        case HashWrapper::SHA512:
+            sha512_hash(Buffer, (unsigned long)Buffer_Size, (sha512_ctx*)m[Function]);
+            break;
+        #endif //MEDIAINFO_SHA2
+        default:;
+    }
+}
+
+//***************************************************************************
+// Threads
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+//Each hash function is computed by a worker, the caller only copies the data
+//Two buffers are used, the caller fills one while the workers hash the other one
+//Workers are kept in a pool for the next files, so the end of a file does not wait for the end of a thread
+class HashWrapper_Worker;
+static CriticalSection                  HashWrapper_Pool_CS;
+static std::vector<HashWrapper_Worker*> HashWrapper_Pool;
+
+//---------------------------------------------------------------------------
+struct hashwrapper_buffer
+{
+    int8u*                              Data;
+    size_t                              Size;
+    size_t                              Size_Max; //Allocated size
+    size_t                              Workers_Pending; //Count of workers which did not yet hash this buffer
+};
+
+//---------------------------------------------------------------------------
+struct hashwrapper_threads
+{
+    CriticalSection                     CS;
+    std::vector<HashWrapper_Worker*>    Workers;
+    hashwrapper_buffer                  Buffers[2];
+    size_t                              Buffer_Count; //Count of buffers given to the workers
+    size_t                              Workers_Running; //Count of workers which did not yet hash all the buffers, once closing
+    bool                                IsClosing;
+    Condition                           Buffer_Free; //A buffer is hashed by all the workers
+    Condition                           Workers_Finished; //All the buffers are hashed, once closing
+};
+
+//---------------------------------------------------------------------------
+class HashWrapper_Worker : public Thread
+{
+public:
+    Condition                           Job_Available; //A buffer is available, or closing
+    hashwrapper_threads*                Threads; //NULL while in the pool, modified with HashWrapper_Pool_CS
+    void**                              m;
+    size_t                              Function;
+    size_t                              Buffer_Count; //Count of buffers hashed by this worker
+
+    void Entry()
+    {
+        for (;;)
+        {
+            Job_Available.Wait();
+            HashWrapper_Pool_CS.Enter();
+            hashwrapper_threads* Threads_Cur=Threads;
+            HashWrapper_Pool_CS.Leave();
+            if (!Threads_Cur)
+                continue; //Signal sent during a previous use
+
+            for (;;)
+            {
+                Threads_Cur->CS.Enter();
+                if (Buffer_Count==Threads_Cur->Buffer_Count)
+                {
+                    bool IsClosing=Threads_Cur->IsClosing;
+                    bool IsLast=IsClosing && !--Threads_Cur->Workers_Running;
+                    Threads_Cur->CS.Leave();
+                    if (IsClosing)
+                    {
+                        HashWrapper_Pool_CS.Enter();
+                        Threads=NULL;
+                        HashWrapper_Pool_CS.Leave();
+                        if (IsLast)
+                            Threads_Cur->Workers_Finished.Signal(); //Last access to Threads_Cur
+                    }
+                    break;
+                }
+                hashwrapper_buffer& Buffer=Threads_Cur->Buffers[Buffer_Count%2];
+                Threads_Cur->CS.Leave();
+
+                HashWrapper_Update(m, Function, Buffer.Data, Buffer.Size);
+                Buffer_Count++;
+
+                Threads_Cur->CS.Enter();
+                bool IsFree=!--Buffer.Workers_Pending;
+                Threads_Cur->CS.Leave();
+                if (IsFree)
+                    Threads_Cur->Buffer_Free.Signal();
+            }
+        }
+    }
+};
+
 
 //***************************************************************************
 // Constructor/Destructor
 //***************************************************************************
 
 //---------------------------------------------------------------------------
-void HashWrapper::Init (const HashFunctions &Functions)
+void HashWrapper::Init (const HashFunctions &Functions, bool Threaded)
 {
     //Init to zero
     if (sizeof(m))
     {
         memset(m, 0, sizeof(m));
     }
+    Threads=NULL;
 
     #if MEDIAINFO_MD5
         if (Functions[MD5])
@@ -106,10 +234,81 @@ void HashWrapper::Init (const HashFunctions &Functions)
             sha512_begin((sha512_ctx*)m[SHA512]);
         }
     #endif //MEDIAINFO_SHA2
+
+    //Threads
+    size_t Functions_Count=0;
+    for (size_t Function=0; Function<HashFunction_Max; Function++)
+        if (m[Function])
+            Functions_Count++;
+    if (Threaded && Functions_Count)
+    {
+        hashwrapper_threads* Threads_New=new hashwrapper_threads;
+        for (size_t Pos=0; Pos<2; Pos++)
+        {
+            Threads_New->Buffers[Pos].Data=NULL;
+            Threads_New->Buffers[Pos].Size=0;
+            Threads_New->Buffers[Pos].Size_Max=0;
+            Threads_New->Buffers[Pos].Workers_Pending=0;
+        }
+        Threads_New->Buffer_Count=0;
+        Threads_New->Workers_Running=0;
+        Threads_New->IsClosing=false;
+        HashWrapper_Pool_CS.Enter();
+        for (size_t Function=0; Function<HashFunction_Max; Function++)
+            if (m[Function])
+            {
+                HashWrapper_Worker* Worker;
+                if (HashWrapper_Pool.empty())
+                {
+                    Worker=new HashWrapper_Worker;
+                    Worker->Threads=NULL;
+                    Worker->Run();
+                }
+                else
+                {
+                    Worker=HashWrapper_Pool.back();
+                    HashWrapper_Pool.pop_back();
+                }
+                Worker->m=m;
+                Worker->Function=Function;
+                Worker->Buffer_Count=0;
+                Worker->Threads=Threads_New;
+                Threads_New->Workers.push_back(Worker);
+            }
+        HashWrapper_Pool_CS.Leave();
+        Threads=Threads_New;
+    }
+}
+
+void HashWrapper::Threads_End ()
+{
+    if (!Threads)
+        return;
+
+    //Waiting for the workers to hash the pending buffers
+    hashwrapper_threads* Threads_Old=(hashwrapper_threads*)Threads;
+    Threads_Old->CS.Enter();
+    Threads_Old->IsClosing=true;
+    Threads_Old->Workers_Running=Threads_Old->Workers.size();
+    Threads_Old->CS.Leave();
+    for (size_t Pos=0; Pos<Threads_Old->Workers.size(); Pos++)
+        Threads_Old->Workers[Pos]->Job_Available.Signal();
+    Threads_Old->Workers_Finished.Wait(); //Signaled once, by the last worker
+
+    //Workers go back to the pool
+    HashWrapper_Pool_CS.Enter();
+    HashWrapper_Pool.insert(HashWrapper_Pool.end(), Threads_Old->Workers.begin(), Threads_Old->Workers.end());
+    HashWrapper_Pool_CS.Leave();
+    for (size_t Pos=0; Pos<2; Pos++)
+        delete[] Threads_Old->Buffers[Pos].Data;
+    delete Threads_Old;
+    Threads=NULL;
 }
 
 HashWrapper::~HashWrapper ()
 {
+    Threads_End();
+
     #if MEDIAINFO_MD5
         delete (struct MD5Context*)m[MD5];
     #endif //MEDIAINFO_MD5
@@ -128,30 +327,51 @@ HashWrapper::~HashWrapper ()
 
 void HashWrapper::Update (const int8u* Buffer, const size_t Buffer_Size)
 {
-    #if MEDIAINFO_MD5
-        if (m[MD5])
-            MD5Update((struct MD5Context*)m[MD5], Buffer, (unsigned int)Buffer_Size);
-    #endif //MEDIAINFO_MD5
+    if (Threads)
+    {
+        hashwrapper_threads* Threads_Cur=(hashwrapper_threads*)Threads;
+        if (!Buffer_Size)
+            return;
 
-    #if MEDIAINFO_SHA1
-        if (m[SHA1])
-            sha1_hash(Buffer, (unsigned long)Buffer_Size, (sha1_ctx*)m[SHA1]);
-    #endif //MEDIAINFO_SHA1
+        //Waiting only if the workers still hash the buffer given before the previous one
+        Threads_Cur->CS.Enter();
+        hashwrapper_buffer& Next=Threads_Cur->Buffers[Threads_Cur->Buffer_Count%2];
+        while (Next.Workers_Pending)
+        {
+            Threads_Cur->CS.Leave();
+            Threads_Cur->Buffer_Free.Wait();
+            Threads_Cur->CS.Enter();
+        }
+        Threads_Cur->CS.Leave();
 
-    #if MEDIAINFO_SHA2
-        if (m[SHA224])
-            sha224_hash(Buffer, (unsigned long)Buffer_Size, (sha224_ctx*)m[SHA224]);
-        if (m[SHA256])
-            sha256_hash(Buffer, (unsigned long)Buffer_Size, (sha256_ctx*)m[SHA256]);
-        if (m[SHA384])
-            sha384_hash(Buffer, (unsigned long)Buffer_Size, (sha384_ctx*)m[SHA384]);
-        if (m[SHA512])
-            sha512_hash(Buffer, (unsigned long)Buffer_Size, (sha512_ctx*)m[SHA512]);
-    #endif //MEDIAINFO_SHA2
+        //Copy, the caller may reuse its buffer as soon as we return
+        if (Next.Size_Max<Buffer_Size)
+        {
+            delete[] Next.Data;
+            Next.Data=new int8u[Buffer_Size];
+            Next.Size_Max=Buffer_Size;
+        }
+        memcpy(Next.Data, Buffer, Buffer_Size);
+        Next.Size=Buffer_Size;
+
+        Threads_Cur->CS.Enter();
+        Next.Workers_Pending=Threads_Cur->Workers.size();
+        Threads_Cur->Buffer_Count++;
+        Threads_Cur->CS.Leave();
+        for (size_t Pos=0; Pos<Threads_Cur->Workers.size(); Pos++)
+            Threads_Cur->Workers[Pos]->Job_Available.Signal();
+        return;
+    }
+
+    for (size_t Function=0; Function<HashFunction_Max; Function++)
+        if (m[Function])
+            HashWrapper_Update(m, Function, Buffer, Buffer_Size);
 }
 
 string HashWrapper::Generate (const HashFunction Function)
 {
+    Threads_End(); //All data must be hashed
+
     #if MEDIAINFO_MD5
         if (Function==MD5 && m[MD5])
         {
@@ -58,7 +58,7 @@ public:
     };
     typedef bitset<HashFunction_Max> HashFunctions;
 
-    HashWrapper                 (const HashFunctions &Functions)                                                {Init(Functions);}
+    HashWrapper                 (const HashFunctions &Functions, bool Threaded=false)                           {Init(Functions, Threaded);}
     HashWrapper                 (const HashFunctions &Functions, const int8u* Buffer, const size_t Buffer_Size) {Init(Functions); Update(Buffer, Buffer_Size);}
     ~HashWrapper                ();
 
@@ -70,8 +70,10 @@ public:
     static string   Hex2String  (const int8u* Digest, const size_t Digest_Size);
 
 private:
-    void    Init(const HashFunctions &Functions);
+    void    Init(const HashFunctions &Functions, bool Threaded=false);
+    void    Threads_End();
     void*   m[HashFunction_Max];
+    void*   Threads; //Data of the worker threads (one per hash function), NULL if hashes are computed by the caller
 };
 
 } //NameSpace
@@ -16,6 +16,7 @@
 //---------------------------------------------------------------------------
 #include "MediaInfo/MediaInfo.h"
 #include "MediaInfo/MediaInfo_Internal.h"
+#include "MediaInfo/OutputHelpers.h"
 #if defined(_MSC_VER) && _MSC_VER >= 1800 && _MSC_VER < 1900 && defined(_M_X64)
     #include <math.h> // needed for _set_FMA3_enable()
 #endif
@@ -150,6 +151,13 @@ String MediaInfo::Inform(size_t)
     return MediaInfo_Internal::Inform(Internal);
 }
 
+//---------------------------------------------------------------------------
+size_t MediaInfo::Inform(void (*CallBack)(const char* Data, size_t Size, void* UserHandler), void* UserHandler)
+{
+    Output_Sink_CallBack Sink(CallBack, UserHandler);
+    return MediaInfo_Internal::Inform(Internal, Sink);
+}
+
 //---------------------------------------------------------------------------
 String MediaInfo::Get(stream_t StreamKind, size_t StreamPos, size_t Parameter, info_t KindOfInfo)
 {
@@ -121,6 +121,14 @@ public :
         /// @pre You can change default presentation with Inform_Set()
         /// @return Text with information about the file
     String Inform (size_t Reserved=0);
+        /// Get all details about a file, given to a callback while it is produced
+        /// @brief Get all details about a file, streamed
+        /// @param CallBack Called with each block of the text, UTF-8 encoded, in order
+        /// @param UserHandler Given back to CallBack
+        /// @pre You can change default presentation with Inform_Set()
+        /// @return Count of bytes given to CallBack
+        /// @note Same bytes as Inform() in UTF-8, XML and JSON outputs are not kept in memory as a whole
+    size_t Inform (void (*CallBack)(const char* Data, size_t Size, void* UserHandler), void* UserHandler);
 
     //Get
         /// Get a piece of information about a file (parameter is an integer)
@@ -142,6 +142,12 @@ size_t MediaInfoList::Open_Buffer_Finalize (size_t FilePos)
     return Internal->Open_Buffer_Finalize(FilePos);
 }
 
+//---------------------------------------------------------------------------
+size_t MediaInfoList::Open_Buffers (size_t Count, const int8u* const* Buffers, const size_t* Buffer_Sizes)
+{
+    return Internal->Open_Buffers(Count, Buffers, Buffer_Sizes);
+}
+
 //---------------------------------------------------------------------------
 size_t MediaInfoList::Save(size_t)
 {
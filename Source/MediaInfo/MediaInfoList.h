@@ -95,6 +95,14 @@ public :
         /// @retval 0 failed
         /// @retval 1 succeed
     size_t Open_Buffer_Finalize (size_t FilePos);
+        /// Open several streams fully in memory and collect information about them, in one call
+        /// @brief Open several streams
+        /// @param Count Count of streams
+        /// @param Buffers pointers to the streams (Count items), a NULL pointer gives an empty result
+        /// @param Buffer_Sizes sizes of the streams (Count items)
+        /// @return File position of the first stream, results are at this position and the next Count-1 ones \n
+        ///         Streams are parsed in parallel if the ParseThreads option is more than 1
+    size_t Open_Buffers (size_t Count, const ZenLib::int8u* const* Buffers, const size_t* Buffer_Sizes);
         /// Save the file opened before with Open() (modifications of tags)
         /// @brief Save the file
         /// @param FilePos File position \n
@@ -26,6 +26,7 @@
 #endif //defined(MEDIAINFO_DIRECTORY_YES)
 #include "MediaInfo/Reader/Reader_Directory.h"
 #include "MediaInfo/File__Analyse_Automatic.h"
+#include "MediaInfo/Condition.h"
 #include <algorithm>
 using namespace ZenLib;
 using namespace std;
@@ -61,6 +62,7 @@ MediaInfoList_Internal::MediaInfoList_Internal(size_t Count_Init)
     BlockMethod=0;
     State=0;
     IsInThread=false;
+    ParseThreads=0;
 }
 
 //---------------------------------------------------------------------------
@@ -153,8 +155,195 @@ size_t MediaInfoList_Internal::Open(const String &File_Name, const fileoptions_t
     }
 }
 
+//***************************************************************************
+// Parsing of several files at the same time
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+struct MediaInfoList_Internal_Job
+{
+    Ztring              FileName;
+    const int8u*        Buffer; //If not NULL, the stream is in memory instead of FileName
+    size_t              Buffer_Size;
+    MediaInfo_Internal* MI;
+    size_t              Index;       //Slot in Info, (size_t)-1 if the slot was removed
+    bool                IsFinished;  //Protected by the list critical section
+    bool                IsCommitted; //MI is in its slot in Info (or deleted if skipped)
+    bool                IsRemoved;   //Part of a sequence of files handled by a previous file
+};
+
+//---------------------------------------------------------------------------
+struct MediaInfoList_Internal_Queue
+{
+    CriticalSection*                        CS;
+    const std::map<String, String>*         Options;         //Options of the instances created by the workers
+    std::deque<MediaInfoList_Internal_Job*> ToDo;            //Dispatched, waiting for a worker
+    Condition                               ToDo_Available;  //A job was added, or workers must exit
+    Condition                               Job_Finished;    //A job is finished, or a worker exited
+    size_t                                  Workers_Running;
+    bool                                    IsClosing;       //Workers exit when ToDo is empty
+};
+
+//---------------------------------------------------------------------------
+static void Open_Buffer_InMemory(MediaInfo_Internal* MI, const int8u* Buffer, size_t Buffer_Size)
+{
+    MI->Open_Buffer_Init(Buffer_Size, (int64u)0);
+    size_t Offset=0;
+    for (size_t Jumps=0; Jumps<256; Jumps++) //Limit in case of a parser asking again and again for the same offset
+    {
+        if (MI->Open_Buffer_Continue(Buffer+Offset, Buffer_Size-Offset)[3]) //Finished
+            break;
+
+        //Jumps are only a change of offset as the whole stream is available
+        int64u GoTo=MI->Open_Buffer_Continue_GoTo_Get();
+        if (GoTo>=Buffer_Size) //No request or beyond the end
+            break;
+        Offset=(size_t)GoTo;
+        MI->Open_Buffer_Init(Buffer_Size, GoTo);
+    }
+    MI->Open_Buffer_Finalize();
+}
+
+//---------------------------------------------------------------------------
+static MediaInfo_Internal* MI_Create(const std::map<String, String> &Options)
+{
+    MediaInfo_Internal* MI=new MediaInfo_Internal();
+    for (std::map<String, String>::const_iterator Option=Options.begin(); Option!=Options.end(); ++Option)
+        MI->Option(Option->first, Option->second);
+    return MI;
+}
+
+//---------------------------------------------------------------------------
+class MediaInfoList_Internal_Worker : public Thread
+{
+public:
+    MediaInfoList_Internal_Queue* Queue;
+    MediaInfo_Internal*           MI; //Parses the streams in memory, their results are moved to the job instance
+
+    MediaInfoList_Internal_Worker()
+    {
+        MI=NULL;
+    }
+
+    ~MediaInfoList_Internal_Worker()
+    {
+        delete MI;
+    }
+
+    void Entry()
+    {
+        for (;;)
+        {
+            MediaInfoList_Internal_Job* Job=NULL;
+            bool ToDo_IsEmpty=true;
+            bool MustExit=false;
+            Queue->CS->Enter();
+            if (!Queue->ToDo.empty())
+            {
+                Job=Queue->ToDo.front();
+                Queue->ToDo.pop_front();
+                ToDo_IsEmpty=Queue->ToDo.empty();
+            }
+            else if (Queue->IsClosing)
+            {
+                Queue->Workers_Running--;
+                MustExit=true;
+            }
+            Queue->CS->Leave();
+
+            if (!ToDo_IsEmpty || MustExit)
+                Queue->ToDo_Available.Signal(); //Only one waiter is woken up per signal, passing it to another idle worker
+            if (MustExit)
+            {
+                Queue->Job_Finished.Signal();
+                break;
+            }
+
+            if (Job)
+            {
+                if (Job->Buffer)
+                {
+                    if (!MI)
+                        MI=MI_Create(*Queue->Options);
+                    Open_Buffer_InMemory(MI, Job->Buffer, Job->Buffer_Size);
+                    MI->Results_Move(Job->MI);
+                }
+                else
+                    Job->MI->Open(Job->FileName);
+
+                Queue->CS->Enter();
+                Job->IsFinished=true;
+                Queue->CS->Leave();
+                Queue->Job_Finished.Signal();
+            }
+            else
+                Queue->ToDo_Available.Wait();
+        }
+    }
+};
+
+//---------------------------------------------------------------------------
+static void Workers_Create(MediaInfoList_Internal_Queue &Queue, std::vector<MediaInfoList_Internal_Worker*> &Workers, size_t Count)
+{
+    Queue.Workers_Running=Count;
+    for (size_t Pos=0; Pos<Count; Pos++)
+    {
+        MediaInfoList_Internal_Worker* Worker=new MediaInfoList_Internal_Worker;
+        Worker->Queue=&Queue;
+        Worker->Run();
+        Workers.push_back(Worker);
+    }
+}
+
+//---------------------------------------------------------------------------
+static void Workers_Delete(MediaInfoList_Internal_Queue &Queue, std::vector<MediaInfoList_Internal_Worker*> &Workers)
+{
+    Queue.CS->Enter();
+    Queue.IsClosing=true;
+    Queue.CS->Leave();
+    Queue.ToDo_Available.Signal();
+
+    for (;;)
+    {
+        Queue.CS->Enter();
+        bool IsDone=Queue.Workers_Running==0;
+        Queue.CS->Leave();
+        if (IsDone)
+            break;
+        Queue.Job_Finished.Wait();
+    }
+
+    //Workers have left their loop, only the end of the thread is remaining
+    for (size_t Pos=0; Pos<Workers.size(); Pos++)
+    {
+        while (!Workers[Pos]->IsExited())
+            Thread::Yield();
+        delete Workers[Pos];
+    }
+    Workers.clear();
+}
+
+//---------------------------------------------------------------------------
+static void Info_Erase(std::vector<MediaInfo_Internal*> &Info, size_t Pos, std::deque<MediaInfoList_Internal_Job*>* Jobs)
+{
+    delete Info[Pos];
+    Info.erase(Info.begin()+Pos);
+
+    //Slots of the files not yet committed are moved too
+    if (Jobs)
+        for (size_t i=0; i<Jobs->size(); i++)
+        {
+            size_t &Index=(*Jobs)[i]->Index;
+            if (Index==Pos)
+                Index=(size_t)-1;
+            else if (Index!=(size_t)-1 && Index>Pos)
+                Index--;
+        }
+}
+
 #if defined(MEDIAINFO_FILE_YES)
-static size_t RemoveFilesFromList(std::queue<String>& ToParse, Ztring CompleteName_Begin, const Ztring &CompleteName_Last)
+//---------------------------------------------------------------------------
+static size_t RemoveFilesFromList(std::queue<String>& ToParse, Ztring CompleteName_Begin, const Ztring &CompleteName_Last, std::deque<MediaInfoList_Internal_Job*>* Jobs=NULL, size_t Jobs_Begin=0)
 {
     size_t Removed=0;
     size_t Pos=0;
@@ -168,6 +357,18 @@ static size_t RemoveFilesFromList(std::queue<String>& ToParse, Ztring CompleteNa
     if (Pos<CompleteName_Begin.size())
     {
         CompleteName_Begin.resize(Pos);
+
+        //Files already given to workers are before the ones still in the queue
+        if (Jobs)
+        {
+            for (size_t i=Jobs_Begin; i<Jobs->size(); i++)
+            {
+                if ((*Jobs)[i]->FileName.find(CompleteName_Begin)!=0)
+                    return Removed; //Sequence ends before the queue
+                (*Jobs)[i]->IsRemoved=true; //Counted as done when committed
+            }
+        }
+
         while (!ToParse.empty() && ToParse.front().find(CompleteName_Begin)==0)
         {
             ToParse.pop();
@@ -183,6 +384,12 @@ void MediaInfoList_Internal::Entry()
     if (ToParse_Total==0)
         return;
 
+    if (ParseThreads>1)
+    {
+        Entry_Parallel();
+        return;
+    }
+
     for (;;)
     {
         CS.Enter();
@@ -231,69 +438,201 @@ void MediaInfoList_Internal::Entry()
             }
             CS.Enter();
             ToParse_AlreadyDone++;
+            Entry_RemoveFiles(MI);
+        }
 
+        State=ToParse_AlreadyDone*10000/ToParse_Total;
+        //if ((ToParse_AlreadyDone%10)==0)
+        //    printf("%f done (%i/%i %s)\n", ((float)State)/100, (int)ToParse_AlreadyDone, (int)ToParse_Total, Ztring(ToParse.front()).To_UTF8().c_str());
+        if (IsTerminating() || State==10000)
+        {
+            CS.Leave();
+            break;
+        }
+        CS.Leave();
+        Yield();
+    }
+}
+
+//---------------------------------------------------------------------------
+void MediaInfoList_Internal::Entry_Parallel()
+{
+    //With Thread option (BlockMethod 1), this method runs in the list thread and Open() has already returned:
+    //each file is visible in Info as soon as it is finished, and Close() stops the dispatching
+    std::deque<MediaInfoList_Internal_Job*> Jobs; //Dispatched, in input order, until all previous files are committed
+    size_t Jobs_Pending=0; //Dispatched and not yet finished
+
+    //Workers
+    MediaInfoList_Internal_Queue Queue;
+    Queue.CS=&CS;
+    Queue.Options=&Config_MediaInfo_Items;
+    Queue.IsClosing=false;
+    std::vector<MediaInfoList_Internal_Worker*> Workers;
+    Workers_Create(Queue, Workers, ParseThreads);
+
+    for (;;)
+    {
+        CS.Enter();
+
+        //Dispatching, with a bounded count of files being parsed; finished files do not count so a slow file does not block the others
+        bool HasNewJobs=false;
+        while (!ToParse.empty() && Jobs_Pending<ParseThreads*2 && !IsTerminating())
+        {
+            Ztring FileName=ToParse.front();
+            ToParse.pop();
             #if defined(MEDIAINFO_FILE_YES)
-                //Removing sequences of files from the list
-                if (!MI->Get(Stream_General, 0, General_CompleteName_Last).empty())
-                    ToParse_AlreadyDone+=RemoveFilesFromList(ToParse, MI->Get(Stream_General, 0, General_CompleteName),
-                                                                      MI->Get(Stream_General, 0, General_CompleteName_Last));
-                if (MI->Config.File_TestDirectory_Get() && MI->Get(Stream_General, 0, General_Format)==__T("Directory"))
+                std::vector<String>::iterator ToIgnore=find(ToParse_ToIgnore.begin(), ToParse_ToIgnore.end(), FileName);
+                if (ToIgnore!=ToParse_ToIgnore.end())
                 {
-                    for (size_t StreamKind=Stream_General+1; StreamKind<Stream_Max; StreamKind++)
-                        for (size_t StreamPos=0; StreamPos<MI->Count_Get((stream_t)StreamKind); StreamPos++)
-                        {
-                            if (!MI->Get((stream_t)StreamKind, StreamPos, __T("Source_Last")).empty())
-                                ToParse_AlreadyDone+=RemoveFilesFromList(ToParse, MI->Get(Stream_General, 0, General_CompleteName)+MI->Get((stream_t)StreamKind, StreamPos, __T("Source")),
-                                                                                  MI->Get(Stream_General, 0, General_CompleteName)+MI->Get((stream_t)StreamKind, StreamPos, __T("Source_Last")));
-                            else
-                            {
-                                Ztring Source=MI->Get((stream_t)StreamKind, StreamPos, __T("Source"));
-                                if (!Source.empty())
-                                {
-                                    Ztring Dir=MI->Get(Stream_General, 0, General_CompleteName);
-                                    if (!Dir.empty() && Dir[Dir.size()-1]!=__T('/') && Dir[Dir.size()-1]!=__T('\\'))
-                                    {
-                                        size_t Separator_Pos=Dir.find_last_of(__T("\\/"));
-                                        if (Separator_Pos!=string::npos)
-                                            Dir.resize(Separator_Pos+1);
-                                        else
-                                            Dir.clear();
-                                    }
-                                    size_t i;
-                                    if (PathSeparator!=__T('/'))
-                                        while ((i=Source.find(__T('/')))!=string::npos)
-                                            Source[i]=PathSeparator;
-                                    if (PathSeparator!=__T('\\'))
-                                        while ((i=Source.find(__T('\\')))!=string::npos)
-                                            Source[i]=PathSeparator;
-                                    Source=Dir+Source;
-                                    i=0;
-                                    for (; i<Info.size(); i++)
-                                        if (Info[i]->Get(Stream_General, 0, General_CompleteName)==Source)
-                                        {
-                                            delete Info[i];
-                                            Info.erase(Info.begin()+i);
-                                        }
-                                    if (i>=Info.size())
-                                        ToParse_ToIgnore.push_back(Source);
-                                }
-                            }
-                        }
+                    ToParse_ToIgnore.erase(ToIgnore);
+                    ToParse_AlreadyDone++;
+                    continue;
+                }
+            #endif //defined(MEDIAINFO_FILE_YES)
+            MediaInfoList_Internal_Job* Job=new MediaInfoList_Internal_Job;
+            Job->FileName=FileName;
+            Job->Buffer=NULL;
+            Job->Buffer_Size=0;
+            Job->MI=new MediaInfo_Internal();
+            for (std::map<String, String>::iterator Config_MediaInfo_Item=Config_MediaInfo_Items.begin(); Config_MediaInfo_Item!=Config_MediaInfo_Items.end(); ++Config_MediaInfo_Item)
+                Job->MI->Option(Config_MediaInfo_Item->first, Config_MediaInfo_Item->second);
+            Job->Index=Info.size();
+            Job->IsFinished=false;
+            Job->IsCommitted=false;
+            Job->IsRemoved=false;
+            Info.push_back(NULL); //Slot reserved in input order, so the output is the same as with only one thread
+            Jobs.push_back(Job);
+            Queue.ToDo.push_back(Job);
+            Jobs_Pending++;
+            HasNewJobs=true;
+        }
+
+        //Files handled by a previous file do not need to be parsed
+        for (size_t Pos=0; Pos<Queue.ToDo.size();)
+        {
+            if (Queue.ToDo[Pos]->IsRemoved || IsTerminating())
+            {
+                Queue.ToDo[Pos]->IsRemoved=true;
+                Queue.ToDo[Pos]->IsFinished=true;
+                Queue.ToDo.erase(Queue.ToDo.begin()+Pos);
+            }
+            else
+                Pos++;
+        }
+
+        //Results, in their slot as soon as they are finished
+        for (size_t Pos=0; Pos<Jobs.size(); Pos++)
+        {
+            MediaInfoList_Internal_Job* Job=Jobs[Pos];
+            if (!Job->IsFinished || Job->IsCommitted)
+                continue;
+            Job->IsCommitted=true;
+            Jobs_Pending--;
+            ToParse_AlreadyDone++;
+            bool Skip=Job->IsRemoved;
+            #if defined(MEDIAINFO_FILE_YES)
+                std::vector<String>::iterator ToIgnore=find(ToParse_ToIgnore.begin(), ToParse_ToIgnore.end(), Job->FileName);
+                if (ToIgnore!=ToParse_ToIgnore.end())
+                {
+                    ToParse_ToIgnore.erase(ToIgnore);
+                    Skip=true;
                 }
             #endif //defined(MEDIAINFO_FILE_YES)
+            if (Skip)
+            {
+                delete Job->MI;
+                if (Job->Index!=(size_t)-1)
+                    Info_Erase(Info, Job->Index, &Jobs);
+            }
+            else
+            {
+                Info[Job->Index]=Job->MI;
+                Entry_RemoveFiles(Job->MI, &Jobs, Pos+1);
+            }
+        }
+
+        //Files which can not be removed anymore by a previous file are forgotten
+        while (!Jobs.empty() && Jobs.front()->IsCommitted)
+        {
+            delete Jobs.front();
+            Jobs.pop_front();
         }
 
         State=ToParse_AlreadyDone*10000/ToParse_Total;
-        //if ((ToParse_AlreadyDone%10)==0)
-        //    printf("%f done (%i/%i %s)\n", ((float)State)/100, (int)ToParse_AlreadyDone, (int)ToParse_Total, Ztring(ToParse.front()).To_UTF8().c_str());
-        if (IsTerminating() || State==10000)
+        if (Jobs.empty() && (ToParse.empty() || IsTerminating()))
         {
             CS.Leave();
             break;
         }
         CS.Leave();
-        Yield();
+
+        if (HasNewJobs)
+            Queue.ToDo_Available.Signal();
+        Queue.Job_Finished.Wait();
     }
+
+    //Deleting workers
+    Workers_Delete(Queue, Workers);
+}
+
+//---------------------------------------------------------------------------
+void MediaInfoList_Internal::Entry_RemoveFiles(MediaInfo_Internal* MI, std::deque<MediaInfoList_Internal_Job*>* Jobs, size_t Jobs_Begin)
+{
+    #if defined(MEDIAINFO_FILE_YES)
+        //Removing sequences of files from the list
+        if (!MI->Get(Stream_General, 0, General_CompleteName_Last).empty())
+            ToParse_AlreadyDone+=RemoveFilesFromList(ToParse, MI->Get(Stream_General, 0, General_CompleteName),
+                                                              MI->Get(Stream_General, 0, General_CompleteName_Last), Jobs, Jobs_Begin);
+        if (MI->Config.File_TestDirectory_Get() && MI->Get(Stream_General, 0, General_Format)==__T("Directory"))
+        {
+            for (size_t StreamKind=Stream_General+1; StreamKind<Stream_Max; StreamKind++)
+                for (size_t StreamPos=0; StreamPos<MI->Count_Get((stream_t)StreamKind); StreamPos++)
+                {
+                    if (!MI->Get((stream_t)StreamKind, StreamPos, __T("Source_Last")).empty())
+                        ToParse_AlreadyDone+=RemoveFilesFromList(ToParse, MI->Get(Stream_General, 0, General_CompleteName)+MI->Get((stream_t)StreamKind, StreamPos, __T("Source")),
+                                                                          MI->Get(Stream_General, 0, General_CompleteName)+MI->Get((stream_t)StreamKind, StreamPos, __T("Source_Last")), Jobs, Jobs_Begin);
+                    else
+                    {
+                        Ztring Source=MI->Get((stream_t)StreamKind, StreamPos, __T("Source"));
+                        if (!Source.empty())
+                        {
+                            Ztring Dir=MI->Get(Stream_General, 0, General_CompleteName);
+                            if (!Dir.empty() && Dir[Dir.size()-1]!=__T('/') && Dir[Dir.size()-1]!=__T('\\'))
+                            {
+                                size_t Separator_Pos=Dir.find_last_of(__T("\\/"));
+                                if (Separator_Pos!=string::npos)
+                                    Dir.resize(Separator_Pos+1);
+                                else
+                                    Dir.clear();
+                            }
+                            size_t i;
+                            if (PathSeparator!=__T('/'))
+                                while ((i=Source.find(__T('/')))!=string::npos)
+                                    Source[i]=PathSeparator;
+                            if (PathSeparator!=__T('\\'))
+                                while ((i=Source.find(__T('\\')))!=string::npos)
+                                    Source[i]=PathSeparator;
+                            Source=Dir+Source;
+                            i=0;
+                            for (; i<Info.size(); i++)
+                                if (Info[i] && Info[i]->Get(Stream_General, 0, General_CompleteName)==Source) //NULL if not yet parsed, then it is ignored when committed
+                                    Info_Erase(Info, i, Jobs);
+                            if (i>=Info.size())
+                                ToParse_ToIgnore.push_back(Source);
+                        }
+                    }
+                }
+        }
+
+        //Files of a sequence may have been committed before the first one
+        if (Jobs)
+            for (size_t i=Jobs_Begin; i<Jobs->size(); i++)
+            {
+                MediaInfoList_Internal_Job* Job=(*Jobs)[i];
+                if (Job->IsRemoved && Job->IsCommitted && Job->Index!=(size_t)-1)
+                    Info_Erase(Info, Job->Index, Jobs);
+            }
+    #endif //defined(MEDIAINFO_FILE_YES)
 }
 
 //---------------------------------------------------------------------------
@@ -338,6 +677,70 @@ size_t MediaInfoList_Internal::Open_Buffer_Finalize (size_t FilePos)
     return Info[FilePos]->Open_Buffer_Finalize();
 }
 
+//---------------------------------------------------------------------------
+size_t MediaInfoList_Internal::Open_Buffers (size_t Count, const int8u* const* Buffers, const size_t* Buffer_Sizes)
+{
+    //Options of the list, the instances parsing the streams are configured once
+    std::map<String, String> Options;
+    size_t Threads;
+    {
+    CriticalSectionLocker CSL(CS);
+    Options=Config_MediaInfo_Items;
+    Threads=ParseThreads<Count?ParseThreads:Count;
+    }
+
+    //Results, a stream without buffer has an empty result
+    std::vector<MediaInfo_Internal*> MIs(Count);
+    for (size_t Pos=0; Pos<Count; Pos++)
+        MIs[Pos]=new MediaInfo_Internal();
+
+    //Parsing
+    if (Threads>1)
+    {
+        CriticalSection Jobs_CS;
+        MediaInfoList_Internal_Queue Queue;
+        Queue.CS=&Jobs_CS;
+        Queue.Options=&Options;
+        Queue.IsClosing=true; //Workers stop when there is nothing more to do
+        std::vector<MediaInfoList_Internal_Job> Jobs(Count);
+        for (size_t Pos=0; Pos<Count; Pos++)
+        {
+            if (!Buffers[Pos])
+                continue;
+            Jobs[Pos].Buffer=Buffers[Pos];
+            Jobs[Pos].Buffer_Size=Buffer_Sizes[Pos];
+            Jobs[Pos].MI=MIs[Pos];
+            Jobs[Pos].Index=Pos;
+            Jobs[Pos].IsFinished=false;
+            Jobs[Pos].IsCommitted=false;
+            Jobs[Pos].IsRemoved=false;
+            Queue.ToDo.push_back(&Jobs[Pos]);
+        }
+
+        std::vector<MediaInfoList_Internal_Worker*> Workers;
+        Workers_Create(Queue, Workers, Threads);
+        Workers_Delete(Queue, Workers);
+    }
+    else
+    {
+        MediaInfo_Internal* MI=MI_Create(Options);
+        for (size_t Pos=0; Pos<Count; Pos++)
+        {
+            if (!Buffers[Pos])
+                continue;
+            Open_Buffer_InMemory(MI, Buffers[Pos], Buffer_Sizes[Pos]);
+            MI->Results_Move(MIs[Pos]);
+        }
+        delete MI;
+    }
+
+    //Results, in input order
+    CriticalSectionLocker CSL(CS);
+    size_t FilePos=Info.size();
+    Info.insert(Info.end(), MIs.begin(), MIs.end());
+    return FilePos;
+}
+
 //---------------------------------------------------------------------------
 size_t MediaInfoList_Internal::Save(size_t)
 {
@@ -351,7 +754,7 @@ void MediaInfoList_Internal::Close(size_t FilePos)
     if (IsRunning())
     {
         RequestTerminate();
-        while(IsExited())
+        while(!IsExited())
             Yield();
     }
 
@@ -383,7 +786,15 @@ String MediaInfoList_Internal::Inform(size_t FilePos, size_t)
 {
     if (FilePos==Error)
     {
-        return MediaInfo_Internal::Inform(Info);
+        //Files being parsed have no slot content yet
+        std::vector<MediaInfo_Internal*> Info_Parsed;
+        {
+        CriticalSectionLocker CSL(CS);
+        for (size_t Pos=0; Pos<Info.size(); Pos++)
+            if (Info[Pos])
+                Info_Parsed.push_back(Info[Pos]);
+        }
+        return MediaInfo_Internal::Inform(Info_Parsed);
     }
 
     CriticalSectionLocker CSL(CS);
@@ -494,8 +905,13 @@ String MediaInfoList_Internal::Option (const String &Option, const String &Value
         BlockMethod=1;
         return __T("");
     }
+    else if (OptionLower==__T("parsethreads"))
+    {
+        ParseThreads=Ztring(Value).To_int32u();
+        return __T("");
+    }
     #if MEDIAINFO_ADVANCED
-        else if (OptionLower.find(__T("file_inform_stringpointer")) == 0 && Info.size() == 1)
+        else if (OptionLower.find(__T("file_inform_stringpointer")) == 0 && Info.size() == 1 && Info[0])
             return Info[0]->Option(Option, Value);
     #endif //MEDIAINFO_ADVANCED
     else if (OptionLower.find(__T("reset"))==0)
@@ -507,7 +923,8 @@ String MediaInfoList_Internal::Option (const String &Option, const String &Value
     else if (OptionLower.find(__T("file_"))==0)
     {
         for (size_t i=0; i<Info.size(); i++) //Applies to both past and future items
-            Info[i]->Option(Option, Value);
+            if (Info[i]) //NULL if being parsed
+                Info[i]->Option(Option, Value);
         Config_MediaInfo_Items[Option]=Value;
         return __T("");
     }
@@ -535,7 +952,8 @@ size_t MediaInfoList_Internal::State_Get()
     {
         State=0;
         for (size_t Pos=0; Pos<Info.size(); Pos++)
-            State+=Info[Pos]->State_Get();
+            if (Info[Pos]) //NULL if being parsed
+                State+=Info[Pos]->State_Get();
         State/=Info.size()+ToParse.size();
     }
 
@@ -19,11 +19,14 @@
 #include "MediaInfo/MediaInfo.h"
 #include "MediaInfo/MediaInfo_Internal.h"
 #include <queue>
+#include <deque>
 //---------------------------------------------------------------------------
 
 namespace MediaInfoLib
 {
 
+struct MediaInfoList_Internal_Job;
+
 class MediaInfoList_Internal : public ZenLib::Thread
 {
 public :
@@ -37,6 +40,7 @@ public :
     size_t Open_Buffer_Continue (size_t FilePos, const ZenLib::int8u* Buffer, size_t Buffer_Size);
     ZenLib::int64u Open_Buffer_Continue_GoTo_Get (size_t FilePos);
     size_t Open_Buffer_Finalize (size_t FilePos);
+    size_t Open_Buffers (size_t Count, const ZenLib::int8u* const* Buffers, const size_t* Buffer_Sizes);
     size_t Save (size_t FilePos);
     void Close (size_t FilePos=(size_t)-1);
     String Inform (size_t FilePos=(size_t)-1, size_t Reserved=0);
@@ -77,6 +81,11 @@ private :
     bool    IsInThread;
     void    Entry();
     ZenLib::CriticalSection CS;
+
+    //Threading - parsing of several files at the same time
+    size_t  ParseThreads; //Count of workers, 0 or 1 means files are parsed one after the other
+    void    Entry_Parallel();
+    void    Entry_RemoveFiles(MediaInfo_Internal* MI, std::deque<MediaInfoList_Internal_Job*>* Jobs=NULL, size_t Jobs_Begin=0);
 };
 
 } //NameSpace
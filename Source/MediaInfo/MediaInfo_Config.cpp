@@ -349,6 +349,22 @@ MediaInfo_Config Config;
 // Constructor/Destructor
 //***************************************************************************
 
+MediaInfo_Config::MediaInfo_Config()
+{
+    for (size_t StreamKind=0; StreamKind<Stream_Max; StreamKind++)
+        Info_Snapshot[StreamKind]=NULL;
+}
+
+//---------------------------------------------------------------------------
+MediaInfo_Config::~MediaInfo_Config()
+{
+    for (size_t StreamKind=0; StreamKind<Stream_Max; StreamKind++)
+        delete Info_Snapshot[StreamKind]; //Info_Snapshot[StreamKind]=NULL;
+    for (size_t Pos=0; Pos<Info_Snapshot_Old.size(); Pos++)
+        delete Info_Snapshot_Old[Pos]; //Info_Snapshot_Old[Pos]=NULL;
+}
+
+//---------------------------------------------------------------------------
 void MediaInfo_Config::Init(bool Force)
 {
     {
@@ -364,6 +380,7 @@ void MediaInfo_Config::Init(bool Force)
         #endif //defined(MEDIAINFO_EBUCORE_YES) || defined(MEDIAINFO_NISO_YES) || MEDIAINFO_ADVANCED
         #ifdef MEDIAINFO_ADVANCED
             ParseOnlyKnownExtensions.clear();
+            Cache_Directory.clear();
         #endif
         Trace_Layers.reset();
         Trace_Modificators.clear();
@@ -388,8 +405,13 @@ void MediaInfo_Config::Init(bool Force)
             Library[Format].clear();
         Iso639_1.clear();
         Iso639_2.clear();
+        Iso639_Names.clear();
         for (size_t StreamKind=0; StreamKind<Stream_Max; StreamKind++)
+        {
             Info[StreamKind].clear();
+            Info_Index[StreamKind].clear();
+            Info_Snapshot_Reset((stream_t)StreamKind);
+        }
         SubFile_Config.clear();
         CustomMapping.clear();
         #if defined(MEDIAINFO_LIBCURL_YES)
@@ -450,6 +472,10 @@ void MediaInfo_Config::Init(bool Force)
     Verbosity=(float32)0.5;
     Trace_Level=(float32)0.0;
     Compat=70778;
+    #if MEDIAINFO_ADVANCED
+        Cache_Hits=0;
+        Cache_Misses=0;
+    #endif //MEDIAINFO_ADVANCED
     Https=true;
     Trace_TimeSection_OnlyFirstOccurrence=false;
     Trace_Format=Trace_Format_Tree;
@@ -818,6 +844,48 @@ Ztring MediaInfo_Config::Option (const String &Option, const String &Value_Raw)
             return __T("advanced features are disabled due to compilation options");
         #endif // MEDIAINFO_ADVANCED
     }
+    if (Option_Lower==__T("cache_directory"))
+    {
+        #if MEDIAINFO_ADVANCED
+            Cache_Directory_Set(Value);
+            return Ztring();
+        #else // MEDIAINFO_ADVANCED
+            return __T("advanced features are disabled due to compilation options");
+        #endif // MEDIAINFO_ADVANCED
+    }
+    if (Option_Lower==__T("cache_directory_get"))
+    {
+        #if MEDIAINFO_ADVANCED
+            return Cache_Directory_Get();
+        #else // MEDIAINFO_ADVANCED
+            return __T("advanced features are disabled due to compilation options");
+        #endif // MEDIAINFO_ADVANCED
+    }
+    if (Option_Lower==__T("cache_hits_get"))
+    {
+        #if MEDIAINFO_ADVANCED
+            return Ztring::ToZtring(Cache_Hits_Get());
+        #else // MEDIAINFO_ADVANCED
+            return __T("advanced features are disabled due to compilation options");
+        #endif // MEDIAINFO_ADVANCED
+    }
+    if (Option_Lower==__T("cache_misses_get"))
+    {
+        #if MEDIAINFO_ADVANCED
+            return Ztring::ToZtring(Cache_Misses_Get());
+        #else // MEDIAINFO_ADVANCED
+            return __T("advanced features are disabled due to compilation options");
+        #endif // MEDIAINFO_ADVANCED
+    }
+    if (Option_Lower==__T("cache_stats_reset"))
+    {
+        #if MEDIAINFO_ADVANCED
+            Cache_Stats_Reset();
+            return Ztring();
+        #else // MEDIAINFO_ADVANCED
+            return __T("advanced features are disabled due to compilation options");
+        #endif // MEDIAINFO_ADVANCED
+    }
     if (Option_Lower==__T("showfiles_set"))
     {
         ShowFiles_Set(Value.c_str());
@@ -1746,6 +1814,49 @@ Ztring MediaInfo_Config::ParseOnlyKnownExtensions_GetList_String()
 }
 #endif //MEDIAINFO_ADVANCED
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_ADVANCED
+void MediaInfo_Config::Cache_Directory_Set (const Ztring &NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    Cache_Directory=NewValue;
+}
+
+Ztring MediaInfo_Config::Cache_Directory_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Cache_Directory;
+}
+
+void MediaInfo_Config::Cache_Stats_Add (bool IsHit)
+{
+    CriticalSectionLocker CSL(CS);
+    if (IsHit)
+        Cache_Hits++;
+    else
+        Cache_Misses++;
+}
+
+void MediaInfo_Config::Cache_Stats_Reset ()
+{
+    CriticalSectionLocker CSL(CS);
+    Cache_Hits=0;
+    Cache_Misses=0;
+}
+
+int64u MediaInfo_Config::Cache_Hits_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Cache_Hits;
+}
+
+int64u MediaInfo_Config::Cache_Misses_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Cache_Misses;
+}
+#endif //MEDIAINFO_ADVANCED
+
 //---------------------------------------------------------------------------
 void MediaInfo_Config::ShowFiles_Set (const ZtringListList &NewShowFiles)
 {
@@ -2198,6 +2309,7 @@ void MediaInfo_Config::Language_Set (stream_t StreamKind)
         //Slashes
 
     }
+    Info_Snapshot_Reset(StreamKind);
 }
 
 Ztring MediaInfo_Config::Language_Get ()
@@ -2725,18 +2837,25 @@ const Ztring &MediaInfo_Config::Iso639_2_Get (const Ztring &Value)
 //---------------------------------------------------------------------------
 const Ztring MediaInfo_Config::Iso639_Find (const Ztring &Value)
 {
-    Translation Info;
-    MediaInfo_Config_DefaultLanguage (Info);
     Ztring Value_Lower(Value);
     Value_Lower.MakeLowerCase();
 
-    for (Translation::iterator Trans=Info.begin(); Trans!=Info.end(); ++Trans)
+    CriticalSectionLocker CSL(CS);
+
+    //Loading names table if not yet done
+    if (Iso639_Names.empty())
     {
-        Trans->second.MakeLowerCase();
-        if (Trans->second==Value_Lower && Trans->first.find(__T("Language_"))==0)
-            return Trans->first.substr(9, string::npos);
+        Translation Info;
+        MediaInfo_Config_DefaultLanguage (Info);
+        for (Translation::iterator Trans=Info.begin(); Trans!=Info.end(); ++Trans)
+            if (Trans->first.find(__T("Language_"))==0)
+                Iso639_Names.insert(std::make_pair(Trans->second.MakeLowerCase(), Trans->first.substr(9, string::npos))); //First code in the default language order is kept
     }
-    return Ztring();
+
+    std::map<Ztring, Ztring>::iterator Name=Iso639_Names.find(Value_Lower);
+    if (Name==Iso639_Names.end())
+        return Ztring();
+    return Name->second;
 }
 
 //---------------------------------------------------------------------------
@@ -2760,6 +2879,7 @@ void MediaInfo_Config::Language_Set_Internal(stream_t KindOfStream)
 {
     //Loading codec table if not yet done
     if (Info[KindOfStream].empty())
+    {
         switch (KindOfStream)
         {
             case Stream_General :   MediaInfo_Config_General(Info[Stream_General]);   Language_Set(Stream_General); break;
@@ -2769,8 +2889,36 @@ void MediaInfo_Config::Language_Set_Internal(stream_t KindOfStream)
             case Stream_Other :     MediaInfo_Config_Other(Info[Stream_Other]);       Language_Set(Stream_Other); break;
             case Stream_Image :     MediaInfo_Config_Image(Info[Stream_Image]);       Language_Set(Stream_Image); break;
             case Stream_Menu :      MediaInfo_Config_Menu(Info[Stream_Menu]);         Language_Set(Stream_Menu); break;
-        default:;
+            default:                return;
         }
+        Info_Index_Set(KindOfStream);
+    }
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config::Info_Index_Set (stream_t StreamKind)
+{
+    //CriticalSectionLocker CSL(CS); //No, only used internaly
+
+    //Same result as Info[StreamKind].Find(): first line with this name
+    Info_Index[StreamKind].clear();
+    for (size_t Pos=0; Pos<Info[StreamKind].size(); Pos++)
+        if (!Info[StreamKind][Pos].empty())
+            Info_Index[StreamKind].insert(std::make_pair(Info[StreamKind][Pos][Info_Name], Pos));
+    Info_Snapshot_Reset(StreamKind);
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config::Info_Snapshot_Reset (stream_t StreamKind)
+{
+    //CriticalSectionLocker CSL(CS); //No, only used internaly
+
+    //Parsers may still read the outdated copy
+    if (Info_Snapshot[StreamKind])
+    {
+        Info_Snapshot_Old.push_back(Info_Snapshot[StreamKind]);
+        Info_Snapshot[StreamKind]=NULL;
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -2779,7 +2927,7 @@ const Ztring &MediaInfo_Config::Info_Get (stream_t KindOfStream, const Ztring &V
     Language_Set_All(KindOfStream);
     if (KindOfStream>=Stream_Max)
         return EmptyString_Get();
-    size_t Pos=Info[KindOfStream].Find(Value);
+    size_t Pos=Info_Find(KindOfStream, Value);
     if (Pos==Error || (size_t)KindOfInfo>=Info[KindOfStream][Pos].size())
         return EmptyString_Get();
     return Info[KindOfStream][Pos][KindOfInfo];
@@ -2806,6 +2954,40 @@ const ZtringListList &MediaInfo_Config::Info_Get(stream_t KindOfStream)
     return Info[KindOfStream];
 }
 
+size_t MediaInfo_Config::Info_Find (stream_t KindOfStream, const Ztring &Value, info_t KindOfSearch)
+{
+    if (KindOfStream>=Stream_Max)
+        return Error;
+
+    Language_Set_All(KindOfStream);
+
+    if (KindOfSearch!=Info_Name)
+        return Info[KindOfStream].Find(Value, KindOfSearch);
+    std::map<Ztring, size_t>::iterator Item=Info_Index[KindOfStream].find(Value);
+    if (Item==Info_Index[KindOfStream].end())
+        return Error;
+    return Item->second;
+}
+
+//---------------------------------------------------------------------------
+const MediaInfo_Config::info_snapshot *MediaInfo_Config::Info_Snapshot_Get (stream_t KindOfStream)
+{
+    if (KindOfStream>=Stream_Max)
+        return NULL;
+
+    CriticalSectionLocker CSL(CS);
+    Language_Set_Internal(KindOfStream);
+    if (!Info_Snapshot[KindOfStream])
+    {
+        //The tables are modified in place by a language change, a reset or HideParameter, so parsers get a copy
+        info_snapshot* Snapshot=new info_snapshot;
+        Snapshot->Info=Info[KindOfStream];
+        Snapshot->Index=Info_Index[KindOfStream];
+        Info_Snapshot[KindOfStream]=Snapshot;
+    }
+    return Info_Snapshot[KindOfStream];
+}
+
 //---------------------------------------------------------------------------
 Ztring MediaInfo_Config::Info_Parameters_Get (bool Complete)
 {
@@ -2821,6 +3003,8 @@ Ztring MediaInfo_Config::Info_Parameters_Get (bool Complete)
     MediaInfo_Config_Other(Info[Stream_Other]);
     MediaInfo_Config_Image(Info[Stream_Image]);
     MediaInfo_Config_Menu(Info[Stream_Menu]);
+    for (size_t StreamKind=0; StreamKind<Stream_Max; StreamKind++)
+        Info_Index_Set((stream_t)StreamKind);
 
     //Building
     size_t ToReturn_Pos=0;
@@ -2872,39 +3056,22 @@ Ztring MediaInfo_Config::HideShowParameter(const Ztring &Value, Char Show)
         if (StreamKind==Stream_Max)
             return List[j]+=__T(" is unknown");
 
-        //Loading codec table if not yet done
-        {
+        //Loading codec table if not yet done, with its index
         CriticalSectionLocker CSL(CS);
-        if (Info[StreamKind].empty())
-            switch (StreamKind)
-            {
-                case Stream_General :   MediaInfo_Config_General(Info[Stream_General]);   Language_Set(Stream_General); break;
-                case Stream_Video :     MediaInfo_Config_Video(Info[Stream_Video]);       Language_Set(Stream_Video); break;
-                case Stream_Audio :     MediaInfo_Config_Audio(Info[Stream_Audio]);       Language_Set(Stream_Audio); break;
-                case Stream_Text :      MediaInfo_Config_Text(Info[Stream_Text]);         Language_Set(Stream_Text); break;
-                case Stream_Other :     MediaInfo_Config_Other(Info[Stream_Other]);       Language_Set(Stream_Other); break;
-                case Stream_Image :     MediaInfo_Config_Image(Info[Stream_Image]);       Language_Set(Stream_Image); break;
-                case Stream_Menu :      MediaInfo_Config_Menu(Info[Stream_Menu]);         Language_Set(Stream_Menu); break;
-                default:;
-            }
-        }
+        Language_Set_Internal(StreamKind);
 
         String FieldName=List[j].substr(List[j].find(__T('_'))+1);
-        bool Found=false;
-        for (size_t i=0; i<Info[StreamKind].size(); i++)
-            if (Info[StreamKind][i](Info_Name)==FieldName)
-            {
-                if (Info_Options<Info[StreamKind][i].size())
-                {
-                    Info[StreamKind][i][Info_Options].resize(InfoOption_Max, __T(' '));
-                    Info[StreamKind][i][Info_Options][InfoOption_ShowInInform]=Show;
-                    Info[StreamKind][i][Info_Options][InfoOption_ShowInXml]=Show;
-                }
-                Found=true;
-                break;
-            }
-        if (!Found)
+        std::map<Ztring, size_t>::iterator Item=Info_Index[StreamKind].find(FieldName);
+        if (Item==Info_Index[StreamKind].end())
             return List[j]+=__T(" is unknown");
+        ZtringList &Line=Info[StreamKind][Item->second];
+        if (Info_Options<Line.size())
+        {
+            Line[Info_Options].resize(InfoOption_Max, __T(' '));
+            Line[Info_Options][InfoOption_ShowInInform]=Show;
+            Line[Info_Options][InfoOption_ShowInXml]=Show;
+        }
+        Info_Snapshot_Reset(StreamKind);
     }
 
     return Ztring();
@@ -28,6 +28,7 @@
 #include "ZenLib/ZtringListList.h"
 #include "ZenLib/Translation.h"
 #include "ZenLib/InfoMap.h"
+#include <map>
 #include <set>
 #include <bitset>
 using namespace ZenLib;
@@ -79,7 +80,8 @@ class MediaInfo_Config
 {
 public :
     //Constructor/Destructor
-    MediaInfo_Config() {}
+    MediaInfo_Config();
+    ~MediaInfo_Config();
     void Init(bool Force=false); //Must be called instead of constructor
 
     //General
@@ -106,6 +108,15 @@ public :
           Ztring    ParseOnlyKnownExtensions_GetList_String();
           #endif //MEDIAINFO_ADVANCED
 
+          #if MEDIAINFO_ADVANCED
+          void      Cache_Directory_Set (const Ztring &NewValue);
+          Ztring    Cache_Directory_Get ();
+          void      Cache_Stats_Add (bool IsHit);
+          void      Cache_Stats_Reset ();
+          int64u    Cache_Hits_Get ();
+          int64u    Cache_Misses_Get ();
+          #endif //MEDIAINFO_ADVANCED
+
           void      ShowFiles_Set (const ZtringListList &NewShowFiles);
           size_t    ShowFiles_Nothing_Get ();
           size_t    ShowFiles_VideoAudio_Get ();
@@ -235,6 +246,13 @@ public :
     const Ztring   &Info_Get (stream_t KindOfStream, const Ztring &Value, info_t KindOfInfo=Info_Text);
     const Ztring   &Info_Get (stream_t KindOfStream, size_t Pos, info_t KindOfInfo=Info_Text);
     const ZtringListList &Info_Get(stream_t KindOfStream); //Should not be, but too difficult to hide it
+          size_t    Info_Find (stream_t KindOfStream, const Ztring &Value, info_t KindOfSearch=Info_Name);
+    struct info_snapshot
+    {
+        ZtringListList           Info;
+        std::map<Ztring, size_t> Index; //Position in Info of each parameter name
+    };
+    const info_snapshot *Info_Snapshot_Get (stream_t KindOfStream); //Never modified, kept until the end of the program, so it can be read without the lock
 
           Ztring    Info_Parameters_Get (bool Complete=false);
           Ztring    HideShowParameter   (const Ztring &Value, ZenLib::Char Show);
@@ -393,6 +411,9 @@ private :
     size_t          MultipleValues;
     #ifdef MEDIAINFO_ADVANCED
     Ztring          ParseOnlyKnownExtensions;
+    Ztring          Cache_Directory; //Results cache, empty if disabled
+    int64u          Cache_Hits;
+    int64u          Cache_Misses;
     #endif
     size_t          ShowFiles_Nothing;
     size_t          ShowFiles_VideoAudio;
@@ -439,7 +460,11 @@ private :
     InfoMap         Library[InfoLibrary_Format_Max];
     InfoMap         Iso639_1;
     InfoMap         Iso639_2;
+    std::map<Ztring, Ztring> Iso639_Names; //Lower case English name --> code, from the default language
     ZtringListList  Info[Stream_Max]; //General info
+    std::map<Ztring, size_t> Info_Index[Stream_Max]; //Position in Info of each parameter name
+    info_snapshot*  Info_Snapshot[Stream_Max]; //Copy of Info and Info_Index, NULL if not yet done or outdated
+    std::vector<info_snapshot*> Info_Snapshot_Old; //Outdated copies, may still be used by parsers
 
     ZtringListList  SubFile_Config;
 
@@ -448,6 +473,8 @@ private :
     ZenLib::CriticalSection CS;
 
     void      Language_Set (stream_t StreamKind);
+    void      Info_Index_Set (stream_t StreamKind);
+    void      Info_Snapshot_Reset (stream_t StreamKind);
     void      Language_Set_Internal(stream_t KindOfStream);
     void      Language_Set_All(stream_t KindOfStream)
     {
@@ -21,6 +21,8 @@
 #include "ZenLib/ZtringListListF.h"
 #if MEDIAINFO_EVENTS
     #include "ZenLib/FileName.h"
+    #include "ZenLib/Thread.h"
+    #include "MediaInfo/Condition.h"
 #endif //MEDIAINFO_EVENTS
 #if MEDIAINFO_IBI || MEDIAINFO_AES
     #include "ThirdParty/base64/base64.h"
@@ -129,6 +131,60 @@ namespace MediaInfoLib
 
 const size_t Buffer_NormalSize=/*188*7;//*/64*1024;
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_EVENTS
+// Demux contents sent by the dispatching thread, deleted when no more referenced
+// They are copied, the parser buffers may be freed or reused as soon as Demux() returns
+class event_packets
+{
+public:
+    ~event_packets ()
+    {
+        for (counts::iterator Count=Counts.begin(); Count!=Counts.end(); ++Count)
+            delete[] Count->first;
+    }
+
+    const int8u* New (const int8u* Source, size_t Size)
+    {
+        int8u* Packet=new int8u[Size];
+        std::memcpy(Packet, Source, Size);
+
+        CriticalSectionLocker CSL(CS);
+        Counts[Packet]=1;
+        return Packet;
+    }
+
+    bool AddRef (const int8u* Packet)
+    {
+        CriticalSectionLocker CSL(CS);
+        counts::iterator Count=Counts.find(Packet);
+        if (Count==Counts.end())
+            return false;
+        Count->second++;
+        return true;
+    }
+
+    bool Release (const int8u* Packet)
+    {
+        CriticalSectionLocker CSL(CS);
+        counts::iterator Count=Counts.find(Packet);
+        if (Count==Counts.end())
+            return false;
+        if (!--Count->second)
+        {
+            delete[] Count->first;
+            Counts.erase(Count);
+        }
+        return true;
+    }
+
+private:
+    typedef std::map<const int8u*, size_t> counts;
+    CriticalSection CS;
+    counts          Counts;
+};
+#endif //MEDIAINFO_EVENTS
+
 //***************************************************************************
 // Info
 //***************************************************************************
@@ -162,19 +218,26 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
         File_MergeBitRateInfo=true;
         File_HighestFormat=true;
         File_ChannelLayout=true;
+        File_Dependencies_Unknown=false;
         #if MEDIAINFO_DEMUX
             File_Demux_Unpacketize_StreamLayoutChange_Skip=false;
         #endif //MEDIAINFO_DEMUX
     #endif //MEDIAINFO_ADVANCED
+    #if MEDIAINFO_HASH
+        Hash_Threaded=true;
+    #endif //MEDIAINFO_HASH
     #if MEDIAINFO_MD5
         File_Md5=false;
     #endif //MEDIAINFO_MD5
     #if defined(MEDIAINFO_REFERENCES_YES)
         File_CheckSideCarFiles=false;
+        File_ReferencesThreads=0;
     #endif //defined(MEDIAINFO_REFERENCES_YES)
     File_TimeToLive=0;
     File_Buffer_Size_Hint_Pointer=NULL;
     File_Buffer_Read_Size=64*1024*1024;
+    File_Mmap=false;
+    File_MaxMemory=0;
     #if MEDIAINFO_AES
         Encryption_Format=Encryption_Format_None;
         Encryption_Method=Encryption_Method_None;
@@ -190,6 +253,11 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
     #endif //MEDIAINFO_FILTER
     #if MEDIAINFO_EVENTS
         Event_CallBackFunction=NULL;
+        Event_Async_Size=0;
+        Event_Async_Policy=Event_Async_Block;
+        Event_Async_Dropped=0;
+        Event_Async=NULL;
+        Event_Packets=NULL;
         Event_UserHandler=NULL;
         SubFile_StreamID=(int64u)-1;
         ParseUndecodableFrames=false;
@@ -204,6 +272,7 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
         Demux_Hevc_Transcode_Iso14496_15_to_AnnexB=false;
         Demux_Unpacketize=false;
         Demux_SplitAudioBlocks=false;
+        Demux_OriginalContent=true;
         Demux_Rate=0;
         Demux_FirstDts=(int64u)-1;
         Demux_FirstFrameNumber=(int64u)-1;
@@ -214,6 +283,8 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
     #endif //MEDIAINFO_IBIUSAGE
     #if MEDIAINFO_IBIUSAGE
         Ibi_Create=false;
+        Ibi_Sidecar=false;
+        Ibi_FromSidecar=false;
     #endif //MEDIAINFO_IBIUSAGE
 
     //Specific
@@ -254,6 +325,9 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
     File_Buffer_Size=0;
     File_Buffer_Repeat=false;
     File_Buffer_Repeat_IsSupported=false;
+    File_Buffer_Copied=0;
+    File_Memory_Used=0;
+    File_Memory_Exceeded=false;
     File_IsGrowing=false;
     File_IsNotGrowingAnymore=false;
     File_IsImageSequence=false;
@@ -275,6 +349,8 @@ MediaInfo_Config_MediaInfo::MediaInfo_Config_MediaInfo()
     File_Size=(int64u)-1;
     ParseSpeed=MediaInfoLib::Config.ParseSpeed_Get();
     ParseSpeed_FromFile=false;
+    Demux=MediaInfoLib::Config.Demux_Get();
+    Demux_FromFile=false;
     IsFinishing=false;
     #if MEDIAINFO_EVENTS
         Config_PerPackage=NULL;
@@ -304,6 +380,8 @@ MediaInfo_Config_MediaInfo::~MediaInfo_Config_MediaInfo()
     delete (std::vector<std::vector<ZtringListList> >*)File_ExpandSubs_Backup; //File_ExpandSubs_Backup=NULL
 
     #if MEDIAINFO_EVENTS
+        Event_Async_Stop();
+        delete (event_packets*)Event_Packets; //Event_Packets=NULL;
         for (events_delayed::iterator Event=Events_Delayed.begin(); Event!=Events_Delayed.end(); ++Event)
             for (size_t Pos=0; Pos<Event->second.size(); Pos++)
                 delete Event->second[Pos]; //Event->second[Pos]=NULL;
@@ -319,6 +397,12 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
     #if MEDIAINFO_EVENTS
         SubFile_Config(Option)=Value;
     #endif //MEDIAINFO_EVENTS
+    #if MEDIAINFO_ADVANCED
+    {
+        CriticalSectionLocker CSL(CS);
+        Cache_Options(Option)=Value;
+    }
+    #endif //MEDIAINFO_ADVANCED
 
     String Option_Lower(Option);
     size_t Egal_Pos=Option_Lower.find(__T('='));
@@ -358,6 +442,34 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
     {
         return Ztring::ToZtring(File_ParseSpeed_Get(), 1);
     }
+    if (Option_Lower==__T("file_demux"))
+    {
+        String Value_Lower(Value);
+        transform(Value_Lower.begin(), Value_Lower.end(), Value_Lower.begin(), (int(*)(int))tolower); //(int(*)(int)) is a patch for unix
+
+             if (Value_Lower==__T("all"))
+            File_Demux_Set(7);
+        else if (Value_Lower==__T("frame"))
+            File_Demux_Set(1);
+        else if (Value_Lower==__T("container"))
+            File_Demux_Set(2);
+        else if (Value_Lower==__T("elementary"))
+            File_Demux_Set(4);
+        else
+            File_Demux_Set(0);
+        return __T("");
+    }
+    else if (Option_Lower==__T("file_demux_get"))
+    {
+        switch (File_Demux_Get())
+        {
+            case 7 : return __T("All");
+            case 1 : return __T("Frame");
+            case 2 : return __T("Container");
+            case 4 : return __T("Elementary");
+            default: return __T("");
+        }
+    }
     if (Option_Lower==__T("file_isdetectingduration"))
     {
         File_IsDetectingDuration_Set(!(Value==__T("0") || Value.empty()));
@@ -617,6 +729,23 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
             return __T("Hash functions are disabled due to compilation options");
         #endif //MEDIAINFO_HASH
     }
+    else if (Option_Lower==__T("file_hash_threaded"))
+    {
+        #if MEDIAINFO_HASH
+            File_Hash_Threaded_Set(!(Value==__T("0") || Value.empty()));
+            return Ztring();
+        #else //MEDIAINFO_HASH
+            return __T("Hash functions are disabled due to compilation options");
+        #endif //MEDIAINFO_HASH
+    }
+    else if (Option_Lower==__T("file_hash_threaded_get"))
+    {
+        #if MEDIAINFO_HASH
+            return File_Hash_Threaded_Get()?"1":"0";
+        #else //MEDIAINFO_HASH
+            return __T("Hash functions are disabled due to compilation options");
+        #endif //MEDIAINFO_HASH
+    }
     else if (Option_Lower==__T("file_checksidecarfiles"))
     {
         #if defined(MEDIAINFO_REFERENCES_YES)
@@ -626,6 +755,23 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
             return __T("Disabled due to compilation options");
         #endif //defined(MEDIAINFO_REFERENCES_YES)
     }
+    else if (Option_Lower==__T("file_referencesthreads"))
+    {
+        #if defined(MEDIAINFO_REFERENCES_YES)
+            File_ReferencesThreads_Set(Ztring(Value).To_int32u());
+            return Ztring();
+        #else //defined(MEDIAINFO_REFERENCES_YES)
+            return __T("Disabled due to compilation options");
+        #endif //defined(MEDIAINFO_REFERENCES_YES)
+    }
+    else if (Option_Lower==__T("file_referencesthreads_get"))
+    {
+        #if defined(MEDIAINFO_REFERENCES_YES)
+            return Ztring::ToZtring(File_ReferencesThreads_Get());
+        #else //defined(MEDIAINFO_REFERENCES_YES)
+            return __T("Disabled due to compilation options");
+        #endif //defined(MEDIAINFO_REFERENCES_YES)
+    }
     else if (Option_Lower==__T("file_filename"))
     {
         File_FileName_Set(Value);
@@ -644,6 +790,23 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
     {
         return File_FileNameFormat_Get();
     }
+    else if (Option_Lower==__T("file_trace_filename"))
+    {
+        #if MEDIAINFO_TRACE
+            File_Trace_FileName_Set(Value);
+            return Ztring();
+        #else //MEDIAINFO_TRACE
+            return __T("Disabled due to compilation options");
+        #endif //MEDIAINFO_TRACE
+    }
+    else if (Option_Lower==__T("file_trace_filename_get"))
+    {
+        #if MEDIAINFO_TRACE
+            return File_Trace_FileName_Get();
+        #else //MEDIAINFO_TRACE
+            return __T("Disabled due to compilation options");
+        #endif //MEDIAINFO_TRACE
+    }
     else if (Option_Lower==__T("file_timetolive"))
     {
         File_TimeToLive_Set(Ztring(Value).To_float64());
@@ -703,6 +866,34 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
     {
         return Ztring::ToZtring((size_t)File_Buffer_Read_Size_Get());
     }
+    else if (Option_Lower==__T("file_buffer_copied_get"))
+    {
+        CriticalSectionLocker CSL(CS);
+        return Ztring::ToZtring(File_Buffer_Copied);
+    }
+    else if (Option_Lower==__T("file_mmap"))
+    {
+        File_Mmap_Set(!(Value==__T("0") || Value.empty()));
+        return __T("");
+    }
+    else if (Option_Lower==__T("file_mmap_get"))
+    {
+        return File_Mmap_Get()?"1":"0";
+    }
+    else if (Option_Lower==__T("file_maxmemory"))
+    {
+        File_MaxMemory_Set(Ztring(Value).To_int64u());
+        return __T("");
+    }
+    else if (Option_Lower==__T("file_maxmemory_get"))
+    {
+        return Ztring::ToZtring(File_MaxMemory_Get());
+    }
+    else if (Option_Lower==__T("file_memory_used_get"))
+    {
+        CriticalSectionLocker CSL(CS);
+        return Ztring::ToZtring(File_Memory_Used);
+    }
     else if (Option_Lower==__T("file_filter"))
     {
         #if MEDIAINFO_FILTER
@@ -824,6 +1015,23 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
             return __T("Demux manager is disabled due to compilation options");
         #endif //MEDIAINFO_DEMUX
     }
+    else if (Option_Lower==__T("file_demux_originalcontent"))
+    {
+        #if MEDIAINFO_DEMUX
+            Demux_OriginalContent_Set(!(Value==__T("0") || Value.empty()));
+            return Ztring();
+        #else //MEDIAINFO_DEMUX
+            return __T("Demux manager is disabled due to compilation options");
+        #endif //MEDIAINFO_DEMUX
+    }
+    else if (Option_Lower==__T("file_demux_originalcontent_get"))
+    {
+        #if MEDIAINFO_DEMUX
+            return Demux_OriginalContent_Get()?"1":"0";
+        #else //MEDIAINFO_DEMUX
+            return __T("Demux manager is disabled due to compilation options");
+        #endif //MEDIAINFO_DEMUX
+    }
     else if (Option_Lower==__T("file_demux_rate"))
     {
         #if MEDIAINFO_DEMUX
@@ -909,6 +1117,26 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
             return __T("IBI support is disabled due to compilation options");
         #endif //MEDIAINFO_IBIUSAGE
     }
+    else if (Option_Lower==__T("file_ibi_sidecar"))
+    {
+        #if MEDIAINFO_IBIUSAGE
+            if (Ztring(Value).To_int64u()==0)
+                Ibi_Sidecar_Set(false);
+            else
+                Ibi_Sidecar_Set(true);
+            return Ztring();
+        #else //MEDIAINFO_IBIUSAGE
+            return __T("IBI support is disabled due to compilation options");
+        #endif //MEDIAINFO_IBIUSAGE
+    }
+    else if (Option_Lower==__T("file_ibi_sidecar_get"))
+    {
+        #if MEDIAINFO_IBIUSAGE
+            return Ibi_Sidecar_Get()?"1":"0";
+        #else //MEDIAINFO_IBIUSAGE
+            return __T("IBI support is disabled due to compilation options");
+        #endif //MEDIAINFO_IBIUSAGE
+    }
     else if (Option_Lower==__T("file_ibi_useibiinfoifavailable"))
     {
         #if MEDIAINFO_IBIUSAGE
@@ -1254,6 +1482,61 @@ Ztring MediaInfo_Config_MediaInfo::Option (const String &Option, const String &V
             return __T("Event manager is disabled due to compilation options");
         #endif //MEDIAINFO_EVENTS
     }
+    else if (Option_Lower==__T("file_event_async"))
+    {
+        #if MEDIAINFO_EVENTS
+            Event_Async_Set(Ztring(Value).To_int32u());
+            return Ztring();
+        #else //MEDIAINFO_EVENTS
+            return __T("Event manager is disabled due to compilation options");
+        #endif //MEDIAINFO_EVENTS
+    }
+    else if (Option_Lower==__T("file_event_async_get"))
+    {
+        #if MEDIAINFO_EVENTS
+            return Ztring::ToZtring(Event_Async_Get());
+        #else //MEDIAINFO_EVENTS
+            return __T("Event manager is disabled due to compilation options");
+        #endif //MEDIAINFO_EVENTS
+    }
+    else if (Option_Lower==__T("file_event_async_policy"))
+    {
+        #if MEDIAINFO_EVENTS
+            Ztring Value_Lower(Value); Value_Lower.MakeLowerCase();
+            if (Value_Lower==__T("block"))
+                Event_Async_Policy_Set(Event_Async_Block);
+            else if (Value_Lower==__T("dropoldest"))
+                Event_Async_Policy_Set(Event_Async_DropOldest);
+            else if (Value_Lower==__T("coalesce"))
+                Event_Async_Policy_Set(Event_Async_Coalesce);
+            else
+                return __T("Unknown policy, must be Block, DropOldest or Coalesce");
+            return Ztring();
+        #else //MEDIAINFO_EVENTS
+            return __T("Event manager is disabled due to compilation options");
+        #endif //MEDIAINFO_EVENTS
+    }
+    else if (Option_Lower==__T("file_event_async_policy_get"))
+    {
+        #if MEDIAINFO_EVENTS
+            switch (Event_Async_Policy_Get())
+            {
+                case Event_Async_DropOldest : return __T("DropOldest");
+                case Event_Async_Coalesce   : return __T("Coalesce");
+                default                     : return __T("Block");
+            }
+        #else //MEDIAINFO_EVENTS
+            return __T("Event manager is disabled due to compilation options");
+        #endif //MEDIAINFO_EVENTS
+    }
+    else if (Option_Lower==__T("file_event_async_dropped_get"))
+    {
+        #if MEDIAINFO_EVENTS
+            return Ztring::ToZtring(Event_Async_Dropped_Get());
+        #else //MEDIAINFO_EVENTS
+            return __T("Event manager is disabled due to compilation options");
+        #endif //MEDIAINFO_EVENTS
+    }
     else
         return __T("Option not known");
 }
@@ -1312,6 +1595,26 @@ float32 MediaInfo_Config_MediaInfo::File_ParseSpeed_Get ()
     return ParseSpeed;
 }
 
+//***************************************************************************
+// File Demux
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::File_Demux_Set (int8u NewValue, bool FromGlobal)
+{
+    CriticalSectionLocker CSL(CS);
+    if (Demux_FromFile && FromGlobal)
+        return; //Priority is file settings
+    Demux=NewValue;
+    Demux_FromFile=!FromGlobal;
+}
+
+int8u MediaInfo_Config_MediaInfo::File_Demux_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Demux;
+}
+
 //***************************************************************************
 // File Is Detecting Duration
 //***************************************************************************
@@ -1755,6 +2058,18 @@ HashWrapper::HashFunctions MediaInfo_Config_MediaInfo::File_Hash_Get ()
     CriticalSectionLocker CSL(CS);
     return Hash_Functions;
 }
+
+void MediaInfo_Config_MediaInfo::File_Hash_Threaded_Set (bool NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    Hash_Threaded=NewValue;
+}
+
+bool MediaInfo_Config_MediaInfo::File_Hash_Threaded_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Hash_Threaded;
+}
 #endif //MEDIAINFO_HASH
 
 //---------------------------------------------------------------------------
@@ -1770,6 +2085,18 @@ bool MediaInfo_Config_MediaInfo::File_CheckSideCarFiles_Get ()
     CriticalSectionLocker CSL(CS);
     return File_CheckSideCarFiles;
 }
+
+void MediaInfo_Config_MediaInfo::File_ReferencesThreads_Set (size_t NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    File_ReferencesThreads=NewValue;
+}
+
+size_t MediaInfo_Config_MediaInfo::File_ReferencesThreads_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_ReferencesThreads;
+}
 #endif //defined(MEDIAINFO_REFERENCES_YES)
 
 //---------------------------------------------------------------------------
@@ -1910,6 +2237,47 @@ bool MediaInfo_Config_MediaInfo::File_ChannelLayout_Get ()
 }
 #endif //MEDIAINFO_ADVANCED
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_ADVANCED
+ZtringListList MediaInfo_Config_MediaInfo::Cache_Options_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Cache_Options;
+}
+
+void MediaInfo_Config_MediaInfo::File_Dependency_Add (const Ztring &FileName)
+{
+    CriticalSectionLocker CSL(CS);
+    if (File_Dependencies.Find(FileName)==Error)
+        File_Dependencies.push_back(FileName);
+}
+
+ZtringList MediaInfo_Config_MediaInfo::File_Dependencies_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_Dependencies;
+}
+
+void MediaInfo_Config_MediaInfo::File_Dependencies_Unknown_Set ()
+{
+    CriticalSectionLocker CSL(CS);
+    File_Dependencies_Unknown=true;
+}
+
+bool MediaInfo_Config_MediaInfo::File_Dependencies_Unknown_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_Dependencies_Unknown;
+}
+
+void MediaInfo_Config_MediaInfo::File_Dependencies_Clear ()
+{
+    CriticalSectionLocker CSL(CS);
+    File_Dependencies.clear();
+    File_Dependencies_Unknown=false;
+}
+#endif //MEDIAINFO_ADVANCED
+
 //---------------------------------------------------------------------------
 #if MEDIAINFO_ADVANCED
 void MediaInfo_Config_MediaInfo::File_HighestFormat_Set (bool NewValue)
@@ -1976,6 +2344,25 @@ Ztring MediaInfo_Config_MediaInfo::File_FileNameFormat_Get ()
     return File_FileNameFormat;
 }
 
+//***************************************************************************
+// Trace
+//***************************************************************************
+
+//---------------------------------------------------------------------------
+#if MEDIAINFO_TRACE
+void MediaInfo_Config_MediaInfo::File_Trace_FileName_Set (const Ztring &NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    File_Trace_FileName=NewValue;
+}
+
+Ztring MediaInfo_Config_MediaInfo::File_Trace_FileName_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_Trace_FileName;
+}
+#endif //MEDIAINFO_TRACE
+
 //***************************************************************************
 // Time to live
 //***************************************************************************
@@ -2079,6 +2466,59 @@ size_t  MediaInfo_Config_MediaInfo::File_Buffer_Read_Size_Get ()
     return File_Buffer_Read_Size;
 }
 
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::File_Mmap_Set (bool NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    File_Mmap=NewValue;
+}
+
+bool MediaInfo_Config_MediaInfo::File_Mmap_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_Mmap;
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::File_MaxMemory_Set (int64u NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    File_MaxMemory=NewValue;
+}
+
+int64u MediaInfo_Config_MediaInfo::File_MaxMemory_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return File_MaxMemory;
+}
+
+//---------------------------------------------------------------------------
+bool MediaInfo_Config_MediaInfo::File_Memory_Reserve (int64u Size)
+{
+    CriticalSectionLocker CSL(CS);
+    if (File_MaxMemory && (File_Memory_Used+Size>File_MaxMemory || File_Memory_Used+Size<File_Memory_Used))
+    {
+        File_Memory_Exceeded=true;
+        return false;
+    }
+    File_Memory_Used+=Size;
+    return true;
+}
+
+void MediaInfo_Config_MediaInfo::File_Memory_Add (int64u Size)
+{
+    CriticalSectionLocker CSL(CS);
+    File_Memory_Used+=Size;
+    if (File_MaxMemory && File_Memory_Used>File_MaxMemory)
+        File_Memory_Exceeded=true;
+}
+
+void MediaInfo_Config_MediaInfo::File_Memory_Release (int64u Size)
+{
+    CriticalSectionLocker CSL(CS);
+    File_Memory_Used=File_Memory_Used>Size?(File_Memory_Used-Size):0;
+}
+
 //***************************************************************************
 // Filter
 //***************************************************************************
@@ -2323,6 +2763,21 @@ bool MediaInfo_Config_MediaInfo::Demux_SplitAudioBlocks_Get()
 }
 #endif //MEDIAINFO_DEMUX
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_DEMUX
+void MediaInfo_Config_MediaInfo::Demux_OriginalContent_Set(bool NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    Demux_OriginalContent = NewValue;
+}
+
+bool MediaInfo_Config_MediaInfo::Demux_OriginalContent_Get()
+{
+    CriticalSectionLocker CSL(CS);
+    return Demux_OriginalContent;
+}
+#endif //MEDIAINFO_DEMUX
+
 //---------------------------------------------------------------------------
 #if MEDIAINFO_DEMUX
 void MediaInfo_Config_MediaInfo::Demux_Rate_Set (float64 NewValue)
@@ -2395,6 +2850,16 @@ void MediaInfo_Config_MediaInfo::Ibi_Set (const Ztring &Value)
 
     CriticalSectionLocker CSL(CS);
     Ibi=Base64::decode(Data_Base64);
+    Ibi_FromSidecar=false;
+}
+
+void MediaInfo_Config_MediaInfo::Ibi_Sidecar_Binary_Set (const string &NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    if (!Ibi.empty() && !Ibi_FromSidecar)
+        return; //Given by the user
+    Ibi=NewValue;
+    Ibi_FromSidecar=!Ibi.empty();
 }
 
 string MediaInfo_Config_MediaInfo::Ibi_Get ()
@@ -2430,6 +2895,19 @@ bool MediaInfo_Config_MediaInfo::Ibi_Create_Get ()
     CriticalSectionLocker CSL(CS);
     return Ibi_Create;
 }
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::Ibi_Sidecar_Set (bool NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    Ibi_Sidecar=NewValue;
+}
+
+bool MediaInfo_Config_MediaInfo::Ibi_Sidecar_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Ibi_Sidecar;
+}
 #endif //MEDIAINFO_IBIUSAGE
 
 #if MEDIAINFO_FIXITY
@@ -2751,6 +3229,8 @@ Ztring MediaInfo_Config_MediaInfo::Event_CallBackFunction_Set (const Ztring &Val
 {
     ZtringList List=Value;
 
+    Event_Async_Flush(); //Pending events go to the previous callback
+
     CriticalSectionLocker CSL(CS);
 
     if (List.empty())
@@ -2775,6 +3255,368 @@ Ztring MediaInfo_Config_MediaInfo::Event_CallBackFunction_Set (const Ztring &Val
 }
 #endif //MEDIAINFO_EVENTS
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_EVENTS
+// Copy of an event, with copies of the buffers it points to
+struct event_async
+{
+    int8u*              Data_Content;
+    size_t              Data_Size;
+    std::vector<int8u*> Buffers;
+    event_packets*      Packets;
+    const int8u*        Packet; //Referenced by this event until the callback returns
+
+    event_async (const int8u* Data_Content_, size_t Data_Size_)
+    {
+        Data_Size=Data_Size_;
+        Data_Content=new int8u[Data_Size];
+        std::memcpy(Data_Content, Data_Content_, Data_Size);
+        Packets=NULL;
+        Packet=NULL;
+    }
+
+    ~event_async ()
+    {
+        delete[] Data_Content; //Data_Content=NULL;
+        for (size_t Pos=0; Pos<Buffers.size(); Pos++)
+            delete[] Buffers[Pos]; //Buffers[Pos]=NULL;
+        if (Packet)
+            Packets->Release(Packet);
+    }
+
+    const int8u* Retain (event_packets* Packets_, const int8u* Source, size_t Size)
+    {
+        if (!Source || !Size)
+            return Source;
+        Packets=Packets_;
+        Packet=Packets->New(Source, Size);
+        return Packet;
+    }
+
+    template<typename T> const T* Copy (const T* Source, size_t Count)
+    {
+        if (!Source || !Count)
+            return Source;
+        int8u* Buffer=new int8u[Count*sizeof(T)];
+        std::memcpy(Buffer, Source, Count*sizeof(T));
+        Buffers.push_back(Buffer);
+        return (const T*)Buffer;
+    }
+};
+
+//---------------------------------------------------------------------------
+static bool Event_Async_IsBytesRead (const event_async* Event)
+{
+    return ((*((int32u*)Event->Data_Content))&0x00FFFFFF)==((MediaInfo_Event_Global_BytesRead<<8)|0) && Event->Data_Size==sizeof(MediaInfo_Event_Global_BytesRead_0);
+}
+
+//---------------------------------------------------------------------------
+// Copies the buffers pointed by the event, false if the event can not be sent later
+static bool Event_Async_Prepare (event_async* Event, event_packets* Packets)
+{
+    int32u EventCode=*((int32u*)Event->Data_Content);
+    if ((EventCode&0x00FFFFFF)==((MediaInfo_Event_Global_Demux<<8)|4) && Event->Data_Size==sizeof(MediaInfo_Event_Global_Demux_4))
+    {
+        MediaInfo_Event_Global_Demux_4* Demux=(MediaInfo_Event_Global_Demux_4*)Event->Data_Content;
+        Demux->Content=Event->Retain(Packets, Demux->Content, Demux->Content_Size); //The callback may keep it with Event_Packet_AddRef
+        Demux->Offsets_Stream=Event->Copy(Demux->Offsets_Stream, Demux->Offsets_Size);
+        Demux->Offsets_Content=Event->Copy(Demux->Offsets_Content, Demux->Offsets_Size);
+        Demux->OriginalContent=Event->Copy(Demux->OriginalContent, Demux->OriginalContent_Size);
+        return true;
+    }
+    if (Event_Async_IsBytesRead(Event))
+    {
+        MediaInfo_Event_Global_BytesRead_0* BytesRead=(MediaInfo_Event_Global_BytesRead_0*)Event->Data_Content;
+        BytesRead->Content=Event->Copy(BytesRead->Content, BytesRead->Content_Size);
+        return true;
+    }
+
+    //Other events with pointers
+    switch ((EventCode>>8)&0xFFFF)
+    {
+        case MediaInfo_Event_Log :
+        case MediaInfo_Event_Global_Demux : //Other versions
+        case MediaInfo_Event_Global_SimpleText :
+        case MediaInfo_Event_Global_BytesRead : //Other versions
+        case MediaInfo_Event_Global_Decoded :
+        case MediaInfo_Event_Global_AttachedFile :
+        case MediaInfo_Event_General_SubFile_Missing :
+        case MediaInfo_Event_General_Start :
+        case MediaInfo_Event_General_SubFile_Start :
+                    return false;
+        case MediaInfo_Event_DvDif_Analysis_Frame :
+                    return (EventCode>>24)!=MediaInfo_Parser_DvDif;
+        default :   return true;
+    }
+}
+
+//---------------------------------------------------------------------------
+// Merge of Event at the end of Previous if both are contiguous BytesRead events
+static bool Event_Async_Merge (event_async* Previous, const event_async* Event)
+{
+    if (!Event_Async_IsBytesRead(Previous) || !Event_Async_IsBytesRead(Event))
+        return false;
+    MediaInfo_Event_Global_BytesRead_0* Previous_BytesRead=(MediaInfo_Event_Global_BytesRead_0*)Previous->Data_Content;
+    const MediaInfo_Event_Global_BytesRead_0* BytesRead=(const MediaInfo_Event_Global_BytesRead_0*)Event->Data_Content;
+    if (Previous_BytesRead->StreamOffset+Previous_BytesRead->Content_Size!=BytesRead->StreamOffset)
+        return false;
+    if (!BytesRead->Content_Size)
+        return true;
+
+    size_t Content_Size=Previous_BytesRead->Content_Size+BytesRead->Content_Size;
+    int8u* Content=new int8u[Content_Size];
+    if (Previous_BytesRead->Content_Size)
+        std::memcpy(Content, Previous_BytesRead->Content, Previous_BytesRead->Content_Size);
+    std::memcpy(Content+Previous_BytesRead->Content_Size, BytesRead->Content, BytesRead->Content_Size);
+    for (size_t Pos=0; Pos<Previous->Buffers.size(); Pos++)
+        delete[] Previous->Buffers[Pos]; //Only the content is copied for BytesRead
+    Previous->Buffers.clear();
+    Previous->Buffers.push_back(Content);
+    Previous_BytesRead->Content=Content;
+    Previous_BytesRead->Content_Size=Content_Size;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+// Bounded ring of events, emptied by its own thread
+class MediaInfo_Config_MediaInfo_EventDispatcher : public Thread
+{
+public:
+    CriticalSection                     CS;
+    std::vector<event_async*>           Ring;
+    size_t                              Ring_Begin;
+    size_t                              Ring_Count;
+    bool                                IsSending;
+    bool                                IsFinished; //Entry() left its loop
+    MediaInfo_Event_CallBackFunction*   CallBackFunction;
+    void*                               UserHandler;
+    Condition                           Event_Available; //An event was added, or the thread must exit
+    Condition                           Slot_Available;  //An event was taken, or the thread exited
+    Condition                           Emptied;         //No more pending event
+
+    MediaInfo_Config_MediaInfo_EventDispatcher (size_t Size)
+        : Ring(Size, (event_async*)NULL), Ring_Begin(0), Ring_Count(0), IsSending(false), IsFinished(false), CallBackFunction(NULL), UserHandler(NULL)
+    {
+    }
+
+    ~MediaInfo_Config_MediaInfo_EventDispatcher ()
+    {
+        for (size_t Pos=0; Pos<Ring.size(); Pos++)
+            delete Ring[Pos]; //Ring[Pos]=NULL;
+    }
+
+    void Entry()
+    {
+        for (;;)
+        {
+            event_async* Event=NULL;
+            CS.Enter();
+            if (Ring_Count)
+            {
+                Event=Ring[Ring_Begin];
+                Ring[Ring_Begin]=NULL;
+                Ring_Begin=(Ring_Begin+1)%Ring.size();
+                Ring_Count--;
+                IsSending=true;
+            }
+            else if (IsTerminating())
+                IsFinished=true;
+            CS.Leave();
+
+            if (Event)
+            {
+                Slot_Available.Signal();
+                CallBackFunction((unsigned char*)Event->Data_Content, Event->Data_Size, UserHandler);
+                delete Event;
+
+                CS.Enter();
+                IsSending=false;
+                bool IsEmpty=!Ring_Count;
+                CS.Leave();
+                if (IsEmpty)
+                    Emptied.Signal();
+            }
+            else if (IsFinished)
+            {
+                Emptied.Signal();
+                Slot_Available.Signal();
+                break;
+            }
+            else
+                Event_Available.Wait();
+        }
+    }
+
+    bool IsEmpty()
+    {
+        CriticalSectionLocker CSL(CS);
+        return IsFinished || (!Ring_Count && !IsSending);
+    }
+
+    bool IsFinished_Get()
+    {
+        CriticalSectionLocker CSL(CS);
+        return IsFinished;
+    }
+
+    void Wait_Empty()
+    {
+        while (!IsEmpty())
+            Emptied.Wait();
+        Emptied.Signal(); //Another thread may also wait for it
+    }
+};
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::Event_Async_Set (size_t NewValue)
+{
+    Event_Async_Stop(); //The ring is created again with the new size
+
+    CriticalSectionLocker CSL(CS);
+    Event_Async_Size=NewValue;
+}
+
+size_t MediaInfo_Config_MediaInfo::Event_Async_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Event_Async_Size;
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::Event_Async_Policy_Set (event_async_policy NewValue)
+{
+    CriticalSectionLocker CSL(CS);
+    Event_Async_Policy=NewValue;
+}
+
+MediaInfo_Config_MediaInfo::event_async_policy MediaInfo_Config_MediaInfo::Event_Async_Policy_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Event_Async_Policy;
+}
+
+//---------------------------------------------------------------------------
+int64u MediaInfo_Config_MediaInfo::Event_Async_Dropped_Get ()
+{
+    CriticalSectionLocker CSL(CS);
+    return Event_Async_Dropped;
+}
+
+//---------------------------------------------------------------------------
+// CS must not be locked, the callback may use this instance
+void MediaInfo_Config_MediaInfo::Event_Async_Flush ()
+{
+    MediaInfo_Config_MediaInfo_EventDispatcher* Dispatcher;
+    {
+    CriticalSectionLocker CSL(CS);
+    Dispatcher=(MediaInfo_Config_MediaInfo_EventDispatcher*)Event_Async;
+    }
+    if (Dispatcher)
+        Dispatcher->Wait_Empty();
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Config_MediaInfo::Event_Async_Stop ()
+{
+    MediaInfo_Config_MediaInfo_EventDispatcher* Dispatcher;
+    {
+    CriticalSectionLocker CSL(CS);
+    Dispatcher=(MediaInfo_Config_MediaInfo_EventDispatcher*)Event_Async;
+    Event_Async=NULL;
+    }
+    if (Dispatcher)
+    {
+        //Pending events are sent before the thread exits
+        Dispatcher->RequestTerminate();
+        Dispatcher->Event_Available.Signal();
+        while (!Dispatcher->IsFinished_Get())
+            Dispatcher->Emptied.Wait();
+
+        //The thread has left its loop, only its end is remaining
+        while (!Dispatcher->IsExited())
+            Thread::Yield();
+        delete Dispatcher; //Dispatcher=NULL;
+    }
+}
+
+//---------------------------------------------------------------------------
+// Called by Event_Send, CS is locked once and is released during the waits
+void MediaInfo_Config_MediaInfo::Event_Async_Send (const int8u* Data_Content, size_t Data_Size)
+{
+    MediaInfo_Config_MediaInfo_EventDispatcher* Dispatcher=(MediaInfo_Config_MediaInfo_EventDispatcher*)Event_Async;
+    if (!Event_Packets)
+        Event_Packets=new event_packets;
+    if (!Dispatcher)
+    {
+        Dispatcher=new MediaInfo_Config_MediaInfo_EventDispatcher(Event_Async_Size);
+        Dispatcher->Run();
+        Event_Async=Dispatcher;
+    }
+    Dispatcher->CS.Enter();
+    Dispatcher->CallBackFunction=Event_CallBackFunction;
+    Dispatcher->UserHandler=Event_UserHandler;
+    Dispatcher->CS.Leave();
+
+    event_async* Event=new event_async(Data_Content, Data_Size);
+    if (!Event_Async_Prepare(Event, (event_packets*)Event_Packets))
+    {
+        //Sent by the parsing thread after the pending events, so the order is kept
+        delete Event;
+        CS.Leave();
+        Dispatcher->Wait_Empty();
+        CS.Enter();
+        Event_CallBackFunction ((unsigned char*)Data_Content, Data_Size, Event_UserHandler);
+        return;
+    }
+
+    for (;;)
+    {
+        Dispatcher->CS.Enter();
+        if (Event_Async_Policy==Event_Async_Coalesce && Dispatcher->Ring_Count && Event_Async_Merge(Dispatcher->Ring[(Dispatcher->Ring_Begin+Dispatcher->Ring_Count-1)%Dispatcher->Ring.size()], Event))
+        {
+            Dispatcher->CS.Leave();
+            delete Event;
+            return;
+        }
+        if (Dispatcher->Ring_Count==Dispatcher->Ring.size() && Event_Async_Policy==Event_Async_DropOldest)
+        {
+            delete Dispatcher->Ring[Dispatcher->Ring_Begin]; Dispatcher->Ring[Dispatcher->Ring_Begin]=NULL;
+            Dispatcher->Ring_Begin=(Dispatcher->Ring_Begin+1)%Dispatcher->Ring.size();
+            Dispatcher->Ring_Count--;
+            Event_Async_Dropped++;
+        }
+        if (Dispatcher->Ring_Count<Dispatcher->Ring.size())
+        {
+            Dispatcher->Ring[(Dispatcher->Ring_Begin+Dispatcher->Ring_Count)%Dispatcher->Ring.size()]=Event;
+            Dispatcher->Ring_Count++;
+            Dispatcher->CS.Leave();
+            Dispatcher->Event_Available.Signal();
+            return;
+        }
+        Dispatcher->CS.Leave();
+
+        //Full, waiting for the dispatching thread
+        CS.Leave();
+        Dispatcher->Slot_Available.Wait();
+        CS.Enter();
+    }
+}
+
+//---------------------------------------------------------------------------
+// No CS, the callback may call it while the parsing thread waits for the dispatching thread
+bool MediaInfo_Config_MediaInfo::Event_Packet_AddRef (const int8u* Packet)
+{
+    event_packets* Packets=(event_packets*)Event_Packets; //Created before the first packet is sent
+    return Packets && Packets->AddRef(Packet);
+}
+
+bool MediaInfo_Config_MediaInfo::Event_Packet_Release (const int8u* Packet)
+{
+    event_packets* Packets=(event_packets*)Event_Packets; //Created before the first packet is sent
+    return Packets && Packets->Release(Packet);
+}
+#endif //MEDIAINFO_EVENTS
+
 //---------------------------------------------------------------------------
 #if MEDIAINFO_EVENTS
 Ztring MediaInfo_Config_MediaInfo::Event_CallBackFunction_Get ()
@@ -3006,7 +3848,10 @@ void MediaInfo_Config_MediaInfo::Event_Send (File__Analyze* Source, const int8u*
         MEDIAINFO_DEBUG1(   "CallBackFunction",
                             Debug+=", EventID=";Debug+=Ztring::ToZtring(LittleEndian2int32u(Data_Content), 16).To_UTF8();)
 
-        Event_CallBackFunction ((unsigned char*)Data_Content, Data_Size, Event_UserHandler);
+        if (Event_Async_Size)
+            Event_Async_Send(Data_Content, Data_Size);
+        else
+            Event_CallBackFunction ((unsigned char*)Data_Content, Data_Size, Event_UserHandler);
 
         MEDIAINFO_DEBUG2(   "CallBackFunction",
                             )
@@ -3017,7 +3862,7 @@ void MediaInfo_Config_MediaInfo::Event_Send (File__Analyze* Source, const int8u*
         MediaInfo_Event_Generic* Event_Generic=(MediaInfo_Event_Generic*)Data_Content;
         if ((Event_Generic->EventCode&0x00FFFFFF)==((MediaInfo_Event_Global_Demux<<8)|0x04)) //Demux version 4
         {
-            if (!MediaInfoLib::Config.Demux_Get())
+            if (!Demux)
                 return;
 
             MediaInfo_Event_Global_Demux_4* Event=(MediaInfo_Event_Global_Demux_4*)Data_Content;
@@ -90,6 +90,9 @@ public :
     void          File_ParseSpeed_Set(float32 NewValue, bool FromGlobal=false);
     float32       File_ParseSpeed_Get();
 
+    void          File_Demux_Set(int8u NewValue, bool FromGlobal=false);
+    int8u         File_Demux_Get();
+
     void          File_IsDetectingDuration_Set (bool NewValue);
     bool          File_IsDetectingDuration_Get ();
 
@@ -162,6 +165,15 @@ public :
         bool          File_ChannelLayout_Get();
 #endif //MEDIAINFO_ADVANCED
 
+    #if MEDIAINFO_ADVANCED
+        ZtringListList Cache_Options_Get (); //Options set on this instance, part of the results cache key
+        void          File_Dependency_Add (const Ztring &FileName); //Other file read or tested during parsing, existing or not
+        ZtringList    File_Dependencies_Get ();
+        void          File_Dependencies_Unknown_Set (); //Other files were read from names found in the file, e.g. references
+        bool          File_Dependencies_Unknown_Get ();
+        void          File_Dependencies_Clear ();
+    #endif //MEDIAINFO_ADVANCED
+
     #if MEDIAINFO_DEMUX
         #if MEDIAINFO_ADVANCED
             void          File_Demux_Unpacketize_StreamLayoutChange_Skip_Set (bool NewValue);
@@ -172,6 +184,8 @@ public :
     #if MEDIAINFO_HASH
         void         File_Hash_Set (HashWrapper::HashFunctions Funtions);
         HashWrapper::HashFunctions File_Hash_Get ();
+        void          File_Hash_Threaded_Set (bool NewValue);
+        bool          File_Hash_Threaded_Get ();
     #endif //MEDIAINFO_HASH
     #if MEDIAINFO_MD5
         void          File_Md5_Set (bool NewValue);
@@ -181,6 +195,8 @@ public :
     #if defined(MEDIAINFO_REFERENCES_YES)
         void          File_CheckSideCarFiles_Set (bool NewValue);
         bool          File_CheckSideCarFiles_Get ();
+        void          File_ReferencesThreads_Set (size_t NewValue);
+        size_t        File_ReferencesThreads_Get ();
     #endif //defined(MEDIAINFO_REFERENCES_YES)
 
     void          File_FileName_Set (const Ztring &NewValue);
@@ -189,6 +205,12 @@ public :
     void          File_FileNameFormat_Set (const Ztring &NewValue);
     Ztring        File_FileNameFormat_Get ();
 
+    #if MEDIAINFO_TRACE
+        //Trace is written to this file while parsing, with the Inform() envelope; Inform() reads it back from the file
+        void          File_Trace_FileName_Set (const Ztring &NewValue);
+        Ztring        File_Trace_FileName_Get ();
+    #endif //MEDIAINFO_TRACE
+
     void          File_TimeToLive_Set (float64 NewValue);
     float64       File_TimeToLive_Get ();
 
@@ -208,6 +230,12 @@ public :
     void          File_Buffer_Read_Size_Set (size_t NewValue);
     size_t        File_Buffer_Read_Size_Get ();
 
+    void          File_Mmap_Set (bool NewValue);
+    bool          File_Mmap_Get ();
+
+    void          File_MaxMemory_Set (int64u NewValue);
+    int64u        File_MaxMemory_Get ();
+
     #if MEDIAINFO_AES
     void          Encryption_Format_Set (const Ztring &Value);
     void          Encryption_Format_Set (encryption_format Value);
@@ -279,6 +307,20 @@ public :
     void          Event_SubFile_Start(const Ztring &FileName_Absolute);
     void          Event_SubFile_Missing(const Ztring &FileName_Relative);
     void          Event_SubFile_Missing_Absolute(const Ztring &FileName_Absolute);
+    enum event_async_policy
+    {
+        Event_Async_Block,      //Parsing waits for a free slot
+        Event_Async_DropOldest, //The oldest pending event is discarded
+        Event_Async_Coalesce    //Contiguous BytesRead events are merged, else parsing waits
+    };
+    void          Event_Async_Set (size_t NewValue);
+    size_t        Event_Async_Get ();
+    void          Event_Async_Policy_Set (event_async_policy NewValue);
+    event_async_policy Event_Async_Policy_Get ();
+    int64u        Event_Async_Dropped_Get ();
+    void          Event_Async_Flush ();
+    bool          Event_Packet_AddRef (const int8u* Packet);
+    bool          Event_Packet_Release (const int8u* Packet);
     #endif //MEDIAINFO_EVENTS
 
     #if MEDIAINFO_DEMUX
@@ -304,6 +346,8 @@ public :
     int8u         Demux_InitData_Get ();
     void          Demux_SplitAudioBlocks_Set(bool NewValue);
     bool          Demux_SplitAudioBlocks_Get();
+    void          Demux_OriginalContent_Set(bool NewValue);
+    bool          Demux_OriginalContent_Get();
     std::map<Ztring, File> Demux_Files;
     #endif //MEDIAINFO_DEMUX
 
@@ -316,6 +360,9 @@ public :
     #if MEDIAINFO_IBIUSAGE
     void          Ibi_Create_Set (bool NewValue);
     bool          Ibi_Create_Get ();
+    void          Ibi_Sidecar_Set (bool NewValue);
+    bool          Ibi_Sidecar_Get ();
+    void          Ibi_Sidecar_Binary_Set (const std::string &NewValue); //Not if an index was given by the user, empty value only clears an index from a sidecar
     #endif //MEDIAINFO_IBIUSAGE
     #if MEDIAINFO_FIXITY
     void          TryToFix_Set (bool NewValue);
@@ -387,6 +434,12 @@ public :
     int8u*        File_Buffer;
     bool          File_Buffer_Repeat;
     bool          File_Buffer_Repeat_IsSupported;
+    int64u        File_Buffer_Copied; //Count of bytes copied by the parsers for buffering
+    int64u        File_Memory_Used; //Bytes accounted against File_MaxMemory
+    bool          File_Memory_Exceeded;
+    bool          File_Memory_Reserve (int64u Size); //Returns false and reserves nothing if the budget would be exceeded
+    void          File_Memory_Add (int64u Size); //Reserves even if the budget is exceeded
+    void          File_Memory_Release (int64u Size);
     bool          File_IsGrowing;
     bool          File_IsNotGrowingAnymore;
     bool          File_IsImageSequence;
@@ -408,6 +461,8 @@ public :
     int64u        File_Size;
     float32       ParseSpeed;
     bool          ParseSpeed_FromFile;
+    int8u         Demux;
+    bool          Demux_FromFile;
     bool          IsFinishing;
     #if MEDIAINFO_EVENTS
     MediaInfo_Config_PerPackage* Config_PerPackage;
@@ -454,21 +509,29 @@ private :
         bool                File_MergeBitRateInfo;
         bool                File_HighestFormat;
         bool                File_ChannelLayout;
+        ZtringListList      Cache_Options;
+        ZtringList          File_Dependencies;
+        bool                File_Dependencies_Unknown;
         #if MEDIAINFO_DEMUX
             bool                File_Demux_Unpacketize_StreamLayoutChange_Skip;
         #endif //MEDIAINFO_DEMUX
     #endif //MEDIAINFO_ADVANCED
     #if MEDIAINFO_HASH
         HashWrapper::HashFunctions Hash_Functions;
+        bool                Hash_Threaded;
     #endif //MEDIAINFO_HASH
     #if MEDIAINFO_MD5
         bool                File_Md5;
     #endif //MEDIAINFO_MD5
     #if defined(MEDIAINFO_REFERENCES_YES)
         bool                File_CheckSideCarFiles;
+        size_t              File_ReferencesThreads;
     #endif //defined(MEDIAINFO_REFERENCES_YES)
     Ztring                  File_FileName;
     Ztring                  File_FileNameFormat;
+    #if MEDIAINFO_TRACE
+        Ztring              File_Trace_FileName;
+    #endif //MEDIAINFO_TRACE
     float64                 File_TimeToLive;
     Ztring                  File_Partial_Begin;
     Ztring                  File_Partial_End;
@@ -476,6 +539,8 @@ private :
     Ztring                  File_ForceParser_Config;
     size_t*                 File_Buffer_Size_Hint_Pointer;
     size_t                  File_Buffer_Read_Size;
+    bool                    File_Mmap;
+    int64u                  File_MaxMemory; //Memory budget of the parsers in bytes, 0 means unlimited
 
     //Extra
     #if MEDIAINFO_AES
@@ -505,6 +570,13 @@ private :
     //Event
     #if MEDIAINFO_EVENTS
     MediaInfo_Event_CallBackFunction* Event_CallBackFunction; //void Event_Handler(unsigned char* Data_Content, size_t Data_Size, void* UserHandler)
+    size_t                  Event_Async_Size; //Count of events waiting for the dispatching thread, 0 means events are sent by the parsing thread
+    event_async_policy      Event_Async_Policy;
+    int64u                  Event_Async_Dropped;
+    void*                   Event_Async; //Dispatching thread, created with the first event
+    void*                   Event_Packets; //Demux contents sent by the dispatching thread, with their reference count
+    void                    Event_Async_Send (const int8u* Data_Content, size_t Data_Size);
+    void                    Event_Async_Stop ();
     struct event_delayed
     {
         int8u* Data_Content;
@@ -544,6 +616,7 @@ private :
     bool                    Demux_Hevc_Transcode_Iso14496_15_to_AnnexB;
     bool                    Demux_Unpacketize;
     bool                    Demux_SplitAudioBlocks;
+    bool                    Demux_OriginalContent; //Copy of the content before unpacketization, in Demux events
     float64                 Demux_Rate;
     int64u                  Demux_FirstDts;
     int64u                  Demux_FirstFrameNumber;
@@ -556,6 +629,8 @@ private :
     #endif //MEDIAINFO_IBIUSAGE
     #if MEDIAINFO_IBIUSAGE
     bool                    Ibi_Create;
+    bool                    Ibi_Sidecar; //IBI read from and written to <file name>.ibi
+    bool                    Ibi_FromSidecar; //Ibi was read from a sidecar, else it was given by the user
     #endif //MEDIAINFO_IBIUSAGE
     #if MEDIAINFO_FIXITY
     bool                    TryToFix;
@@ -288,13 +288,13 @@ struct MediaInfo_Event_Global_Demux_4
     MEDIAINFO_EVENT_GENERIC
     MediaInfo_int8u         Content_Type; /*MediaInfo_Event_Global_Demux_0_contenttype*/
     size_t                  Content_Size;
-    const MediaInfo_int8u*  Content;
+    const MediaInfo_int8u*  Content; /* Valid until the callback returns. With File_Event_Async, may be kept with File_Event_Packet_AddRef then File_Event_Packet_Release (value: "memory://<Content>") */
     MediaInfo_int64u        Flags; /*bit0=random_access*/
     size_t                  Offsets_Size;
     const MediaInfo_int64u* Offsets_Stream; /* From the begin of the stream */
     const MediaInfo_int64u* Offsets_Content; /* From the begin of the demuxed content */
     size_t                  OriginalContent_Size; /* In case of decoded content inside MediaInfo, OriginalContent contain the not-decoded stream */
-    const MediaInfo_int8u*  OriginalContent; /* In case of decoded content inside MediaInfo, OriginalContent contain the not-decoded stream */
+    const MediaInfo_int8u*  OriginalContent; /* In case of decoded content inside MediaInfo, OriginalContent contain the not-decoded stream (NULL with File_Demux_OriginalContent=0) */
 };
 
 /*-------------------------------------------------------------------------*/
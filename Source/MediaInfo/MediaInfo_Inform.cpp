@@ -104,8 +104,33 @@ void MediaInfo_Internal::ConvertRetour(Ztring& Retour)
     Retour.FindAndReplace(__T("\r"), __T("\n"), 0, Ztring_Recursive);
     Retour.FindAndReplace(__T("\n"), MediaInfoLib::Config.LineSeparator_Get(), 0, Ztring_Recursive);
 }
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Inform_ConvertRetour(Ztring& Retour)
+{
+    Retour.FindAndReplace(__T("\\"), __T("|SC1|"), 0, Ztring_Recursive);
+    ConvertRetour(Retour);
+
+    //Special characters
+    Retour.FindAndReplace(__T("|SC1|"), __T("\\"), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC2|"), __T("["), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC3|"), __T("]"), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC4|"), __T(","), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC5|"), __T(";"), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC6|"), __T("("), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC7|"), __T(")"), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC8|"), __T(")"), 0, Ztring_Recursive);
+    Retour.FindAndReplace(__T("|SC9|"), __T("),"), 0, Ztring_Recursive);
+}
+
 //---------------------------------------------------------------------------
 Ztring MediaInfo_Internal::Inform()
+{
+    return Inform((Output_Sink*)NULL);
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Inform(Output_Sink* Sink)
 {
     {
         CriticalSectionLocker CSL(CS);
@@ -118,6 +143,8 @@ Ztring MediaInfo_Internal::Inform()
         {
             if (!Details.empty())
                 return Ztring().From_UTF8(Details);
+            else if (!Trace_Stream_FileName.empty())
+                return Trace_Stream_Body_Get();
             else if (Info)
                 return Info->Details_Get();
             else
@@ -411,10 +438,13 @@ Ztring MediaInfo_Internal::Inform()
 
     if (HTML) Retour+=__T("\n</body>\n</html>\n");
 
+    //Trees are converted while serialized, directly to Sink if any
     #if defined(MEDIAINFO_XML_YES)
         if (XML || XML_0_7_78_MA || XML_0_7_78_MI)
         {
-            Retour=Ztring().From_UTF8(To_XML(*Node_Main, 0, false, false));
+            Output_Sink_Inform Converter(Retour, Sink);
+            To_XML(*Node_Main, 0, Converter, false, false);
+            Converter.Flush();
             delete Node_Main;
             delete Node_MI;
         }
@@ -422,25 +452,18 @@ Ztring MediaInfo_Internal::Inform()
     #if defined(MEDIAINFO_JSON_YES)
         if (JSON)
         {
-            Retour=__T("{\n")+Ztring().From_UTF8(To_JSON(*Node_Main, 0, false, false))+__T("\n}");
+            Output_Sink_Inform Converter(Retour, Sink);
+            Converter+="{\n";
+            To_JSON(*Node_Main, 0, Converter, false, false);
+            Converter+="\n}";
+            Converter.Flush();
             delete Node_Main;
             delete Node_MI;
         }
     #endif //MEDIAINFO_JSON_YES
 
-    Retour.FindAndReplace(__T("\\"), __T("|SC1|"), 0, Ztring_Recursive);
-    ConvertRetour(Retour);
-
-    //Special characters
-    Retour.FindAndReplace(__T("|SC1|"), __T("\\"), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC2|"), __T("["), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC3|"), __T("]"), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC4|"), __T(","), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC5|"), __T(";"), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC6|"), __T("("), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC7|"), __T(")"), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC8|"), __T(")"), 0, Ztring_Recursive);
-    Retour.FindAndReplace(__T("|SC9|"), __T("),"), 0, Ztring_Recursive);
+    if (!XML && !XML_0_7_78_MA && !XML_0_7_78_MI && !JSON)
+        Inform_ConvertRetour(Retour);
 
     #if MEDIAINFO_TRACE
         if (XML_0_7_78_MA)
@@ -848,7 +871,7 @@ Ztring MediaInfo_Internal::Inform (stream_t StreamKind, size_t StreamPos, bool I
         Elements(0)=Elements(0).SubString(__T("%"), __T("%"));
 
         //Test if there is something to replace
-        size_t Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(Elements(0));
+        size_t Pos=MediaInfoLib::Config.Info_Find(StreamKind, Elements(0));
         if (Pos!=std::string::npos)
         {
             if (Get(StreamKind, StreamPos, Pos).size()>0)
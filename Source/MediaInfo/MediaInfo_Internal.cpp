@@ -21,6 +21,7 @@
 #include "MediaInfo/MediaInfo_Config.h"
 #include "MediaInfo/File__Analyze.h"
 #include "MediaInfo/File__MultipleParsing.h"
+#include "MediaInfo/OutputHelpers.h"
 #if defined(MEDIAINFO_FILE_YES)
 #include "ZenLib/File.h"
 #endif //defined(MEDIAINFO_DIRECTORY_YES)
@@ -48,7 +49,18 @@
     #include "ThirdParty/base64/base64.h"
     #include "zlib.h"
 #endif //MEDIAINFO_COMPRESS
+#if MEDIAINFO_IBIUSAGE
+    #include "ThirdParty/base64/base64.h"
+#endif //MEDIAINFO_IBIUSAGE
 #include <cmath>
+#if MEDIAINFO_ADVANCED || MEDIAINFO_IBIUSAGE
+    #ifdef WINDOWS
+        #undef __TEXT
+        #include <windows.h>
+    #else //WINDOWS
+        #include <unistd.h>
+    #endif //WINDOWS
+#endif //MEDIAINFO_ADVANCED || MEDIAINFO_IBIUSAGE
 #ifdef MEDIAINFO_DEBUG_WARNING_GET
     #include <iostream>
 #endif //MEDIAINFO_DEBUG_WARNING_GET
@@ -782,6 +794,11 @@ MediaInfo_Internal::MediaInfo_Internal()
         Reader=NULL;
     #endif //!defined(MEDIAINFO_READER_NO)
     Info_IsMultipleParsing=false;
+    #if MEDIAINFO_TRACE
+        Trace_Stream=NULL;
+        Trace_Stream_Body_Begin=(int64u)-1;
+        Trace_Stream_Body_End=(int64u)-1;
+    #endif //MEDIAINFO_TRACE
 
     Stream.resize(Stream_Max);
     Stream_More.resize(Stream_Max);
@@ -822,6 +839,12 @@ size_t MediaInfo_Internal::Open(const String &File_Name_)
 {
     Close();
 
+    //IBI sidecar
+    #if MEDIAINFO_IBIUSAGE
+        if (Config.Ibi_Sidecar_Get())
+            Ibi_Sidecar_Load(File_Name_);
+    #endif //MEDIAINFO_IBIUSAGE
+
     //External IBI
     #if MEDIAINFO_IBIUSAGE
         if (Config.Ibi_UseIbiInfoIfAvailable_Get())
@@ -860,8 +883,28 @@ size_t MediaInfo_Internal::Open(const String &File_Name_)
     }
     Config.File_Names_Pos=1;
     Config.IsFinishing=false;
+    #if MEDIAINFO_ADVANCED
+        Config.File_Dependencies_Clear();
+    #endif //MEDIAINFO_ADVANCED
     }
 
+    //Results cache
+    #if MEDIAINFO_ADVANCED
+        Ztring Cache_Key, Cache_FileName;
+        if (BlockMethod!=1 && Config.File_Names.size()==1)
+            Cache_FileName=Cache_FileName_Get(File_Name_, Cache_Key);
+        if (!Cache_FileName.empty())
+        {
+            bool IsHit=Cache_Load(Cache_FileName, Cache_Key);
+            MediaInfoLib::Config.Cache_Stats_Add(IsHit);
+            if (IsHit)
+            {
+                Config.State_Set(1);
+                return Count_Get(Stream_General);
+            }
+        }
+    #endif //MEDIAINFO_ADVANCED
+
     //Parsing
     if (BlockMethod==1)
     {
@@ -875,10 +918,361 @@ size_t MediaInfo_Internal::Open(const String &File_Name_)
     else
     {
         Entry(); //Normal parsing
+        #if MEDIAINFO_ADVANCED
+            if (!Cache_FileName.empty() && Config.File_Names.size()==1 && !Config.File_Dependencies_Unknown_Get() && Count_Get(Stream_General)) //Not if the parser added files (sequences, references...)
+                Cache_Save(Cache_FileName, Cache_Key);
+        #endif //MEDIAINFO_ADVANCED
+        #if MEDIAINFO_IBIUSAGE
+            if (Config.Ibi_Sidecar_Get() && Config.Ibi_Create_Get() && Config.File_Names.size()==1)
+                Ibi_Sidecar_Save(File_Name_);
+        #endif //MEDIAINFO_IBIUSAGE
         return Count_Get(Stream_General);
     }
 }
 
+//***************************************************************************
+// Results cache
+//***************************************************************************
+
+#if MEDIAINFO_ADVANCED || MEDIAINFO_IBIUSAGE
+//---------------------------------------------------------------------------
+// Name of a file written aside then moved, unique between processes and instances
+static Ztring Temp_FileName_Get(const Ztring &File_Name, const void* Instance)
+{
+    #ifdef WINDOWS
+        int64u ProcessId=GetCurrentProcessId();
+    #else //WINDOWS
+        int64u ProcessId=getpid();
+    #endif //WINDOWS
+    return File_Name+__T('.')+Ztring::ToZtring(ProcessId)+__T('.')+Ztring::ToZtring((size_t)Instance, 16)+__T(".tmp");
+}
+#endif //MEDIAINFO_ADVANCED || MEDIAINFO_IBIUSAGE
+
+#if MEDIAINFO_ADVANCED
+//---------------------------------------------------------------------------
+// Entry layout: magic, key, other files (name, size, modification date; empty
+// size if the file did not exist), parser name, then for each stream kind the
+// Stream and Stream_More tables; strings are UTF-8 with a 32-bit LE length
+static const char* Cache_Magic="MICache2";
+static const size_t Cache_Magic_Size=8;
+static const int64u Cache_Size_Max=0x4000000; //64 MiB, anything bigger is not a cache entry
+
+//---------------------------------------------------------------------------
+static void Cache_Put(std::string &Data, int32u Value)
+{
+    char Temp[4];
+    int32u2LittleEndian(Temp, Value);
+    Data.append(Temp, 4);
+}
+
+static void Cache_Put(std::string &Data, const Ztring &Value)
+{
+    std::string Temp=Value.To_UTF8();
+    Cache_Put(Data, (int32u)Temp.size());
+    Data+=Temp;
+}
+
+static void Cache_Put(std::string &Data, const ZtringList &Value)
+{
+    Cache_Put(Data, (int32u)Value.size());
+    for (size_t Pos=0; Pos<Value.size(); Pos++)
+        Cache_Put(Data, Value[Pos]);
+}
+
+static void Cache_Put(std::string &Data, const ZtringListList &Value)
+{
+    Cache_Put(Data, (int32u)Value.size());
+    for (size_t Pos=0; Pos<Value.size(); Pos++)
+        Cache_Put(Data, Value[Pos]);
+}
+
+//---------------------------------------------------------------------------
+static bool Cache_Get(const std::string &Data, size_t &Offset, int32u &Value)
+{
+    if (Data.size()-Offset<4)
+        return false;
+    Value=LittleEndian2int32u(Data.c_str()+Offset);
+    Offset+=4;
+    return true;
+}
+
+static bool Cache_Get(const std::string &Data, size_t &Offset, Ztring &Value)
+{
+    int32u Size;
+    if (!Cache_Get(Data, Offset, Size) || Size>Data.size()-Offset)
+        return false;
+    if (Size)
+        Value.From_UTF8(Data.c_str()+Offset, 0, Size);
+    else
+        Value.clear();
+    Offset+=Size;
+    return true;
+}
+
+static bool Cache_Get(const std::string &Data, size_t &Offset, ZtringList &Value)
+{
+    int32u Count;
+    if (!Cache_Get(Data, Offset, Count) || Count>(Data.size()-Offset)/4) //Each item has at least its size
+        return false;
+    Value.resize(Count);
+    for (size_t Pos=0; Pos<Count; Pos++)
+        if (!Cache_Get(Data, Offset, Value[Pos]))
+            return false;
+    return true;
+}
+
+static bool Cache_Get(const std::string &Data, size_t &Offset, ZtringListList &Value)
+{
+    int32u Count;
+    if (!Cache_Get(Data, Offset, Count) || Count>(Data.size()-Offset)/4) //Each item has at least its size
+        return false;
+    Value.resize(Count);
+    for (size_t Pos=0; Pos<Count; Pos++)
+        if (!Cache_Get(Data, Offset, Value[Pos]))
+            return false;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+// Name, size and modification date of another file, only the name if it does not exist
+static ZtringList Cache_Dependency_Get(const Ztring &File_Name)
+{
+    ZtringList Dependency;
+    Dependency.push_back(File_Name);
+    if (File::Exists(File_Name))
+    {
+        Dependency.push_back(Ztring::ToZtring(File::Size_Get(File_Name)));
+        Dependency.push_back(File::Modified_Get(File_Name));
+    }
+    return Dependency;
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Cache_FileName_Get(const String &File_Name, Ztring &Key)
+{
+    Ztring Directory=MediaInfoLib::Config.Cache_Directory_Get();
+    if (Directory.empty() || File_Name.find(__T("://"))!=string::npos || !File::Exists(File_Name))
+        return Ztring(); //Only local files have a reliable size and modification date
+
+    //Results depending on what is sent during parsing are not cached
+    if (Config.File_Demux_Get())
+        return Ztring();
+    #if MEDIAINFO_NEXTPACKET
+        if (Config.NextPacket_Get())
+            return Ztring();
+    #endif //MEDIAINFO_NEXTPACKET
+    #if MEDIAINFO_EVENTS
+        if (Config.Event_CallBackFunction_IsSet())
+            return Ztring();
+    #endif //MEDIAINFO_EVENTS
+    #if MEDIAINFO_TRACE
+        if (MediaInfoLib::Config.Trace_Level_Get())
+            return Ztring();
+    #endif //MEDIAINFO_TRACE
+    #if MEDIAINFO_IBIUSAGE
+        if (Config.Ibi_Create_Get())
+            return Ztring();
+    #endif //MEDIAINFO_IBIUSAGE
+    #if defined(MEDIAINFO_REFERENCES_YES)
+        if (Config.File_CheckSideCarFiles_Get())
+            return Ztring(); //Side car files may be added or removed at any time
+    #endif //defined(MEDIAINFO_REFERENCES_YES)
+
+    //Key, any change of the file, of the library or of an option modifying the results invalidates the entry
+    Key=File_Name;
+    Key+=__T('\n');
+    Key+=Ztring::ToZtring(File::Size_Get(File_Name));
+    Key+=__T('\n');
+    Key+=File::Modified_Get(File_Name);
+    Key+=__T('\n');
+    Key+=MediaInfo_Version;
+    Key+=__T('\n');
+    Key+=Ztring::ToZtring(Config.File_ParseSpeed_Get(), 3);
+    Key+=__T('\n');
+    Key+=Ztring::ToZtring(MediaInfoLib::Config.Compat_Get());
+    Key+=MediaInfoLib::Config.ReadByHuman_Get()?__T('1'):__T('0');
+    Key+=MediaInfoLib::Config.Legacy_Get()?__T('1'):__T('0');
+    Key+=MediaInfoLib::Config.SkipBinaryData_Get()?__T('1'):__T('0');
+    #if MEDIAINFO_HASH
+        Key+=__T('\n');
+        Key+=Ztring().From_UTF8(Config.File_Hash_Get().to_string());
+    #endif //MEDIAINFO_HASH
+    Key+=__T('\n');
+    Key+=MediaInfoLib::Config.SubFile_Config_Get().Read(); //All options set on the library
+    Key+=__T('\n');
+    Key+=Config.Cache_Options_Get().Read(); //All options set on this instance
+
+    //File name, from the key hash (FNV-1a), the full key is checked when loading
+    std::string Key_UTF8=Key.To_UTF8();
+    int64u Hash=0xCBF29CE484222325LL;
+    for (size_t Pos=0; Pos<Key_UTF8.size(); Pos++)
+    {
+        Hash^=(int8u)Key_UTF8[Pos];
+        Hash*=0x00000100000001B3LL;
+    }
+    Ztring Hash_String=Ztring::ToZtring(Hash, 16);
+    Hash_String.insert(0, 16-Hash_String.size(), __T('0'));
+
+    if (Directory[Directory.size()-1]!=__T('/') && Directory[Directory.size()-1]!=__T('\\'))
+        Directory+=PathSeparator;
+    return Directory+Hash_String+__T(".micache");
+}
+
+//---------------------------------------------------------------------------
+bool MediaInfo_Internal::Cache_Load(const Ztring &Cache_FileName, const Ztring &Key)
+{
+    File F;
+    if (!F.Open(Cache_FileName))
+        return false;
+    int64u Size=F.Size_Get();
+    if (Size<Cache_Magic_Size || Size>Cache_Size_Max)
+        return false;
+    std::string Data;
+    Data.resize((size_t)Size);
+    if (F.Read((int8u*)&Data[0], (size_t)Size)!=Size)
+        return false;
+    F.Close();
+
+    //Header
+    if (Data.compare(0, Cache_Magic_Size, Cache_Magic, Cache_Magic_Size))
+        return false;
+    size_t Offset=Cache_Magic_Size;
+    Ztring Key_FromFile;
+    if (!Cache_Get(Data, Offset, Key_FromFile) || Key_FromFile!=Key)
+        return false; //Other file, other version or other options
+    ZtringListList Dependencies_FromFile;
+    if (!Cache_Get(Data, Offset, Dependencies_FromFile))
+        return false;
+    for (size_t Pos=0; Pos<Dependencies_FromFile.size(); Pos++)
+        if (Dependencies_FromFile[Pos].empty() || Cache_Dependency_Get(Dependencies_FromFile[Pos][0])!=Dependencies_FromFile[Pos])
+            return false; //Another file was created, modified or deleted
+
+    //Tables, fully decoded before being used so a damaged entry is only a miss
+    std::vector<std::vector<ZtringList> > Stream_FromFile(Stream_Max);
+    std::vector<std::vector<ZtringListList> > Stream_More_FromFile(Stream_Max);
+    Ztring ParserName_FromFile;
+    if (!Cache_Get(Data, Offset, ParserName_FromFile))
+        return false;
+    for (size_t StreamKind=Stream_General; StreamKind<Stream_Max; StreamKind++)
+    {
+        int32u Count;
+        if (!Cache_Get(Data, Offset, Count) || Count>(Data.size()-Offset)/4)
+            return false;
+        Stream_FromFile[StreamKind].resize(Count);
+        for (size_t StreamPos=0; StreamPos<Count; StreamPos++)
+            if (!Cache_Get(Data, Offset, Stream_FromFile[StreamKind][StreamPos]))
+                return false;
+        if (!Cache_Get(Data, Offset, Count) || Count>(Data.size()-Offset)/4)
+            return false;
+        Stream_More_FromFile[StreamKind].resize(Count);
+        for (size_t StreamPos=0; StreamPos<Count; StreamPos++)
+            if (!Cache_Get(Data, Offset, Stream_More_FromFile[StreamKind][StreamPos]))
+                return false;
+    }
+    if (Offset!=Data.size())
+        return false;
+
+    CriticalSectionLocker CSL(CS);
+    Stream.swap(Stream_FromFile);
+    Stream_More.swap(Stream_More_FromFile);
+    ParserName=ParserName_FromFile;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Cache_Save(const Ztring &Cache_FileName, const Ztring &Key)
+{
+    std::string Data(Cache_Magic, Cache_Magic_Size);
+    Cache_Put(Data, Key);
+    ZtringList Dependencies=Config.File_Dependencies_Get();
+    ZtringListList Dependencies_Info;
+    for (size_t Pos=0; Pos<Dependencies.size(); Pos++)
+    {
+        if (Dependencies[Pos].find(__T("://"))!=string::npos)
+            return; //Only local files have a reliable size and modification date
+        Dependencies_Info.push_back(Cache_Dependency_Get(Dependencies[Pos]));
+    }
+    Cache_Put(Data, Dependencies_Info);
+    {
+    CriticalSectionLocker CSL(CS);
+    Cache_Put(Data, ParserName);
+    for (size_t StreamKind=Stream_General; StreamKind<Stream_Max; StreamKind++)
+    {
+        Cache_Put(Data, (int32u)Stream[StreamKind].size());
+        for (size_t StreamPos=0; StreamPos<Stream[StreamKind].size(); StreamPos++)
+            Cache_Put(Data, Stream[StreamKind][StreamPos]);
+        Cache_Put(Data, (int32u)Stream_More[StreamKind].size());
+        for (size_t StreamPos=0; StreamPos<Stream_More[StreamKind].size(); StreamPos++)
+            Cache_Put(Data, Stream_More[StreamKind][StreamPos]);
+    }
+    }
+    if (Data.size()>Cache_Size_Max)
+        return;
+
+    //Written aside then moved, so a reader never sees a partial entry
+    Ztring Cache_FileName_Temp=Temp_FileName_Get(Cache_FileName, this);
+    File F;
+    if (!F.Create(Cache_FileName_Temp))
+        return;
+    size_t Written=F.Write((const int8u*)Data.c_str(), Data.size());
+    F.Close();
+    if (Written!=Data.size() || !File::Move(Cache_FileName_Temp, Cache_FileName, true))
+        File::Delete(Cache_FileName_Temp);
+}
+#endif //MEDIAINFO_ADVANCED
+
+//***************************************************************************
+// IBI sidecar
+//***************************************************************************
+
+#if MEDIAINFO_IBIUSAGE
+//---------------------------------------------------------------------------
+static const int64u Ibi_Sidecar_Size_Max=0x10000000; //256 MiB, anything bigger is not an index
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Ibi_Sidecar_Load(const String &File_Name)
+{
+    //Only an index written after the last modification of the file is trusted
+    std::string Data;
+    Ztring Ibi_FileName=File_Name+__T(".ibi");
+    if (File::Exists(File_Name) && File::Exists(Ibi_FileName) && File::Modified_Get(Ibi_FileName)>=File::Modified_Get(File_Name))
+    {
+        File F;
+        if (F.Open(Ibi_FileName))
+        {
+            int64u Size=F.Size_Get();
+            if (Size && Size<=Ibi_Sidecar_Size_Max)
+            {
+                Data.resize((size_t)Size);
+                if (F.Read((int8u*)&Data[0], (size_t)Size)!=Size)
+                    Data.clear();
+            }
+        }
+    }
+    Config.Ibi_Sidecar_Binary_Set(Data); //Emptied if there is no index, the one of the sidecar of the previous file is not kept
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Ibi_Sidecar_Save(const String &File_Name)
+{
+    Ztring IbiText=Get(Stream_General, 0, __T("IBI"));
+    if (IbiText.empty())
+        return;
+    std::string Data=Base64::decode(IbiText.To_UTF8());
+
+    //Written aside then moved, so a reader never sees a partial index
+    Ztring Ibi_FileName=File_Name+__T(".ibi");
+    Ztring Ibi_FileName_Temp=Temp_FileName_Get(Ibi_FileName, this);
+    File F;
+    if (!F.Create(Ibi_FileName_Temp))
+        return;
+    size_t Written=F.Write((const int8u*)Data.c_str(), Data.size());
+    F.Close();
+    if (Written!=Data.size() || !File::Move(Ibi_FileName_Temp, Ibi_FileName, true))
+        File::Delete(Ibi_FileName_Temp);
+}
+#endif //MEDIAINFO_IBIUSAGE
+
 //---------------------------------------------------------------------------
 void MediaInfo_Internal::Entry()
 {
@@ -1045,13 +1439,9 @@ void MediaInfo_Internal::Entry()
                         if (File::Exists(Test))
                         {
                             MediaInfo_Internal MI;
-                            Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-                            Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-                            MI.Option(__T("ParseSpeed"), __T("0"));
-                            MI.Option(__T("Demux"), Ztring());
+                            MI.Option(__T("File_ParseSpeed"), __T("0"));
+                            MI.Option(__T("File_Demux"), Ztring());
                             size_t MiOpenResult=MI.Open(Test);
-                            MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                            MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                             if (MiOpenResult)
                             {
                                 Ztring Format=MI.Get(Stream_General, 0, General_Format);
@@ -1204,6 +1594,25 @@ size_t MediaInfo_Internal::Open_Buffer_Init (int64u File_Size_, const String &Fi
     #endif //MEDIAINFO_TRACE
     if (!File_Name.empty())
         Info->File_Name=File_Name;
+    #if MEDIAINFO_TRACE
+        //Trace streaming, the candidates of File__MultipleParsing do not write, only the parser which is kept
+        if (Trace_Stream==NULL && !Config.File_IsSub_Get() && MediaInfoLib::Config.Trace_Level_Get() && MediaInfoLib::Config.Trace_Format_Get()!=MediaInfo_Config::Trace_Format_CSV)
+        {
+            Ztring Trace_FileName=Config.File_Trace_FileName_Get();
+            if (!Trace_FileName.empty())
+            {
+                Trace_Stream=new File;
+                if (!Trace_Stream->Create(Trace_FileName))
+                {
+                    MediaInfoLib::Config.Log_Send(0xC0, 0xFF, 0, Trace_FileName+__T(", trace file can not be created"));
+                    delete Trace_Stream; Trace_Stream=NULL;
+                }
+                Trace_Stream_FileName.clear();
+                Trace_Stream_Body_Begin=(int64u)-1;
+                Trace_Stream_Body_End=(int64u)-1;
+            }
+        }
+    #endif //MEDIAINFO_TRACE
     Info->Open_Buffer_Init(File_Size_);
 
     if (File_Name.empty())
@@ -1382,6 +1791,10 @@ std::bitset<32> MediaInfo_Internal::Open_Buffer_Continue (const int8u* ToAdd, si
         delete Info_ToDelete; //Info_ToDelete=NULL;
         Info_IsMultipleParsing=false;
     }
+    #if MEDIAINFO_TRACE
+        if (Trace_Stream && !Info_IsMultipleParsing && Info->Status[File__Analyze::IsAccepted])
+            Trace_Stream_Begin(); //Trace done before acceptance is written with the next element
+    #endif //MEDIAINFO_TRACE
 
     #if 0 //temp, for old users
     //The parser wanted seek but the buffer is not seekable
@@ -1462,7 +1875,26 @@ size_t MediaInfo_Internal::Open_Buffer_Finalize ()
     if (Info==NULL)
         return 0;
 
+    #if MEDIAINFO_TRACE
+        if (Trace_Stream && !Info_IsMultipleParsing)
+            Trace_Stream_Begin(); //Not accepted, what remains is written by the parser
+    #endif //MEDIAINFO_TRACE
     Info->Open_Buffer_Finalize();
+    #if MEDIAINFO_EVENTS
+        Config.Event_Async_Flush(); //All events are delivered when the parsing is finished
+    #endif //MEDIAINFO_EVENTS
+    #if MEDIAINFO_TRACE
+        if (Trace_Stream && !Details.empty())
+        {
+            //Detection was not handed to a single parser, the trace was kept in memory
+            Trace_Stream_Begin();
+            if (Trace_Stream && Trace_Stream->Write((const int8u*)Details.data(), Details.size())!=Details.size())
+                MediaInfoLib::Config.Log_Send(0xC0, 0xFF, 0, __T("Trace file write error"));
+            Details.clear();
+        }
+        if (Trace_Stream && !Config.Demux_EventWasSent)
+            Trace_Stream_End();
+    #endif //MEDIAINFO_TRACE
     #if MEDIAINFO_DEMUX
         if (Config.Demux_EventWasSent)
             return 0;
@@ -1549,6 +1981,102 @@ void MediaInfo_Internal::Close()
     #if !defined(MEDIAINFO_READER_NO)
         delete Reader; Reader=NULL;
     #endif //defined(MEDIAINFO_READER_NO)
+    #if MEDIAINFO_TRACE
+        if (Trace_Stream)
+            Trace_Stream_End(); //After Info, which flushes its trace when deleted
+        Trace_Stream_FileName.clear();
+    #endif //MEDIAINFO_TRACE
+    Config.File_Memory_Used=0;
+    Config.File_Memory_Exceeded=false;
+}
+
+//---------------------------------------------------------------------------
+#if MEDIAINFO_TRACE
+void MediaInfo_Internal::Trace_Stream_Begin()
+{
+    //Envelope, same as Inform()
+    if (Trace_Stream_Body_Begin==(int64u)-1)
+    {
+        #if defined(MEDIAINFO_XML_YES)
+            Ztring Options, CompleteName, Parser;
+            if (!Stream[Stream_General].empty())
+            {
+                Options=MediaInfoLib::Config.Info_Get(Stream_General, General_CompleteName, Info_Options);
+                if (General_CompleteName<Stream[Stream_General][0].size())
+                    CompleteName=Stream[Stream_General][0][General_CompleteName];
+            }
+            if (Info && !Info_IsMultipleParsing)
+                Parser.From_UTF8(Info->ParserName);
+            Ztring Header=Trace_Header_Get();
+            if (!Header.empty())
+                Header+=Trace_Media_Header_Get(Options, CompleteName, Parser);
+            string Header_UTF8=Header.To_UTF8();
+            if (Trace_Stream->Write((const int8u*)Header_UTF8.data(), Header_UTF8.size())!=Header_UTF8.size())
+            {
+                MediaInfoLib::Config.Log_Send(0xC0, 0xFF, 0, __T("Trace file write error"));
+                delete Trace_Stream; Trace_Stream=NULL;
+                return;
+            }
+        #endif //defined(MEDIAINFO_XML_YES)
+        Trace_Stream_Body_Begin=Trace_Stream->Position_Get();
+    }
+
+    if (Info && !Info_IsMultipleParsing)
+        Info->Trace_Stream_Set(Trace_Stream);
+}
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Trace_Stream_End()
+{
+    if (Trace_Stream_Body_Begin==(int64u)-1)
+        Trace_Stream_Begin();
+    if (Info)
+        Info->Trace_Stream_Set(NULL); //Everything is flushed
+    if (Trace_Stream==NULL)
+        return;
+
+    Trace_Stream_Body_End=Trace_Stream->Position_Get();
+    #if defined(MEDIAINFO_XML_YES)
+        Ztring Footer=Trace_Footer_Get();
+        if (!Footer.empty())
+            Footer.insert(0, Trace_Media_Footer_Get());
+        string Footer_UTF8=Footer.To_UTF8();
+        if (Trace_Stream->Write((const int8u*)Footer_UTF8.data(), Footer_UTF8.size())!=Footer_UTF8.size())
+            MediaInfoLib::Config.Log_Send(0xC0, 0xFF, 0, __T("Trace file write error"));
+    #endif //defined(MEDIAINFO_XML_YES)
+    delete Trace_Stream; Trace_Stream=NULL;
+    Trace_Stream_FileName=Config.File_Trace_FileName_Get();
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Trace_Stream_Body_Get()
+{
+    //The trace is read back from the file only if requested
+    File F;
+    if (!F.Open(Trace_Stream_FileName) || Trace_Stream_Body_End<Trace_Stream_Body_Begin || !F.GoTo(Trace_Stream_Body_Begin))
+        return Ztring();
+    string Body;
+    Body.resize((size_t)(Trace_Stream_Body_End-Trace_Stream_Body_Begin));
+    if (!Body.empty() && F.Read((int8u*)&Body[0], Body.size())!=Body.size())
+        return Ztring();
+    return Ztring().From_UTF8(Body);
+}
+#endif //MEDIAINFO_TRACE
+
+//---------------------------------------------------------------------------
+void MediaInfo_Internal::Results_Move(MediaInfo_Internal* Target)
+{
+    {
+    CriticalSectionLocker CSL(CS);
+    CriticalSectionLocker CSL_Target(Target->CS);
+    Target->Stream.swap(Stream);
+    Target->Stream_More.swap(Stream_More);
+    Target->Details.swap(Details);
+    Target->ParserName=ParserName;
+    Details.clear();
+    ParserName.clear();
+    }
+    Close();
 }
 
 //***************************************************************************
@@ -1865,14 +2393,14 @@ Ztring MediaInfo_Internal::Get(stream_t StreamKind, size_t StreamPos, const Stri
         CS.Leave();
         const Ztring InformZtring=Inform(StreamKind, StreamPos, true);
         CS.Enter();
-        size_t Pos=MediaInfoLib::Config.Info_Get(StreamKind).Find(__T("Inform"));
+        size_t Pos=MediaInfoLib::Config.Info_Find(StreamKind, __T("Inform"));
         if (Pos!=Error)
             Stream[StreamKind][StreamPos](Pos)=InformZtring;
     }
 #endif
 
     //Case of specific info
-    size_t ParameterI=MediaInfoLib::Config.Info_Get(StreamKind).Find(Parameter, KindOfSearch);
+    size_t ParameterI=MediaInfoLib::Config.Info_Find(StreamKind, Parameter, KindOfSearch);
     if (ParameterI==Error)
     {
         ParameterI=Stream_More[StreamKind][StreamPos].Find(Parameter, KindOfSearch);
@@ -1960,6 +2488,21 @@ size_t MediaInfo_Internal::Output_Buffer_Get (size_t Pos)
 //---------------------------------------------------------------------------
 String MediaInfo_Internal::Option (const String &Option, const String &Value)
 {
+    #if MEDIAINFO_EVENTS
+    {
+        //Without CS, called from the event callback while the parsing thread owns it
+        Ztring OptionLower=Option; OptionLower.MakeLowerCase();
+        if (OptionLower==__T("file_event_packet_addref") || OptionLower==__T("file_event_packet_release"))
+        {
+            Ztring Packet=Value;
+            if (Packet.find(__T("memory://"))==0)
+                Packet.erase(0, 9);
+            bool IsOk=OptionLower==__T("file_event_packet_addref")?Config.Event_Packet_AddRef((const int8u*)Packet.To_int64u()):Config.Event_Packet_Release((const int8u*)Packet.To_int64u());
+            return IsOk?Ztring():Ztring(__T("Unknown packet, only Demux contents sent by the event dispatching thread are reference counted"));
+        }
+    }
+    #endif //MEDIAINFO_EVENTS
+
     CriticalSectionLocker CSL(CS);
     MEDIAINFO_DEBUG_CONFIG_TEXT(Debug+=__T("Option, Option=");Debug+=Ztring(Option);Debug+=__T(", Value=");Debug+=Ztring(Value);)
     Ztring OptionLower=Option; OptionLower.MakeLowerCase();
@@ -2192,6 +2735,79 @@ void MediaInfo_Internal::Event_Prepare (struct MediaInfo_Event_Generic* Event)
 }
 #endif // MEDIAINFO_EVENTS
 
+//---------------------------------------------------------------------------
+#if defined(MEDIAINFO_XML_YES)
+Ztring MediaInfo_Internal::Trace_Header_Get()
+{
+    Ztring Result;
+    if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
+    {
+        Result+=__T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")+MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T('<');
+        Result+=__T("MediaTrace");
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T("    xmlns=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace\"");
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T("    xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"");
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T("    xsi:schemaLocation=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace/mediatrace_0_1.xsd\"");
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T("    version=\"0.1\"");
+        Result+=__T(">")+MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T("<creatingLibrary version=\"")+Ztring(MediaInfo_Version).SubString(__T(" - v"), Ztring())+__T("\" url=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/MediaInfo\">MediaInfoLib</creatingLibrary>");
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+    }
+    else if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_MICRO_XML)
+    {
+        Result+=__T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")+MediaInfoLib::Config.LineSeparator_Get();
+        Result+=__T('<');
+        Result+=__T("MicroMediaTrace");
+        Result+=__T(" xmlns=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace\"");
+        Result+=__T(" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"");
+        Result+=__T(" mtsl=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace/micromediatrace.xsd\"");
+        Result+=__T(" version=\"0.1\">");
+        Result+=__T("<creatingLibrary version=\"")+Ztring(MediaInfo_Version).SubString(__T(" - v"), Ztring())+__T("\" url=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/MediaInfo\">MediaInfoLib</creatingLibrary>");
+    }
+    return Result;
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Trace_Footer_Get()
+{
+    if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
+        return __T("</MediaTrace>")+MediaInfoLib::Config.LineSeparator_Get();
+    else if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_MICRO_XML)
+        return __T("</MicroMediaTrace>");
+    return Ztring();
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Trace_Media_Header_Get(const Ztring &Options, const Ztring &CompleteName, const Ztring &Parser)
+{
+    size_t Modified;
+    Ztring Result;
+    Result+=__T("<media");
+    if (InfoOption_ShowInInform<Options.size() && Options[InfoOption_ShowInInform]==__T('Y'))
+        Result+=__T(" ref=\"")+MediaInfo_Internal::Xml_Content_Escape(CompleteName, Modified)+__T("\"");
+    if (!Parser.empty())
+        Result+=__T(" parser=\"")+Parser+__T("\"");
+    Result+= __T('>');
+    if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+    return Result;
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Trace_Media_Footer_Get()
+{
+    Ztring Result;
+    Result+=__T("</media>");
+    if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
+        Result+=MediaInfoLib::Config.LineSeparator_Get();
+    return Result;
+}
+#endif //defined(MEDIAINFO_XML_YES)
+
 //---------------------------------------------------------------------------
 Ztring MediaInfo_Internal::Inform(MediaInfo_Internal* Info)
 {
@@ -2200,11 +2816,62 @@ Ztring MediaInfo_Internal::Inform(MediaInfo_Internal* Info)
     return MediaInfoLib::MediaInfo_Internal::Inform(Info2);
 }
 
+//---------------------------------------------------------------------------
+size_t MediaInfo_Internal::Inform(MediaInfo_Internal* Info, Output_Sink &Sink)
+{
+    std::vector<MediaInfoLib::MediaInfo_Internal*> Info2;
+    Info2.push_back(Info);
+    return MediaInfoLib::MediaInfo_Internal::Inform(Info2, Sink);
+}
+
+//---------------------------------------------------------------------------
+namespace
+{
+bool LineSeparator_Missing(const Ztring& Result, const Output_Sink_Counted* Sink)
+{
+    if (!Result.empty())
+        return Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n');
+    return Sink && Sink->Size && Sink->Last!='\r' && Sink->Last!='\n';
+}
+
+void Inform_Append(Ztring& Result, MediaInfo_Internal* MI, Output_Sink_Counted* Sink)
+{
+    if (!Sink)
+    {
+        Result+=MI->Inform();
+        return;
+    }
+
+    //What is before is written first, then the file is written while serialized
+    *Sink+=Result.To_UTF8();
+    Result=MI->Inform(Sink);
+}
+} //namespace
+
+//---------------------------------------------------------------------------
+size_t MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info, Output_Sink &Sink)
+{
+    Output_Sink_Counted Result(Sink);
+    Inform(Info, &Result);
+    return Result.Size;
+}
+
 //---------------------------------------------------------------------------
 Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
+{
+    return Inform(Info, NULL);
+}
+
+//---------------------------------------------------------------------------
+Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info, Output_Sink_Counted* Sink)
 {
     Ztring Result;
 
+    #if MEDIAINFO_COMPRESS
+        if (MediaInfoLib::Config.FlagsX_Get(Flags_Inform_zlib) || MediaInfoLib::Config.FlagsX_Get(Flags_Inform_base64))
+            Sink=NULL; //Compressed as a whole
+    #endif //MEDIAINFO_COMPRESS
+
     #if defined(MEDIAINFO_XML_YES)
     if (MediaInfoLib::Config.Inform_Get()==__T("MAXML"))
     {
@@ -2224,9 +2891,9 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
         Result+=MediaInfoLib::Config.LineSeparator_Get();
 
         for (size_t FilePos=0; FilePos<Info.size(); FilePos++)
-            Result+=Info[FilePos]->Inform();
+            Inform_Append(Result, Info[FilePos], Sink);
 
-        if (!Result.empty() && Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n'))
+        if (LineSeparator_Missing(Result, Sink))
             Result+=MediaInfoLib::Config.LineSeparator_Get();
         Result+=__T("</MediaArea");
         Result+=__T(">")+MediaInfoLib::Config.LineSeparator_Get();
@@ -2234,71 +2901,34 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
 
     else if (MediaInfoLib::Config.Trace_Level_Get() && MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
     {
-        Result+=__T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")+MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T('<');
-        Result+=__T("MediaTrace");
-        Result+=MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("    xmlns=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace\"");
-        Result+=MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("    xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"");
-        Result+=MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("    xsi:schemaLocation=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/mediatrace/mediatrace_0_1.xsd\"");
-        Result+=MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("    version=\"0.1\"");
-        Result+=__T(">")+MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("<creatingLibrary version=\"")+Ztring(MediaInfo_Version).SubString(__T(" - v"), Ztring())+__T("\" url=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/MediaInfo\">MediaInfoLib</creatingLibrary>");
-        Result+=MediaInfoLib::Config.LineSeparator_Get();
+        Result+=Trace_Header_Get();
 
         for (size_t FilePos=0; FilePos<Info.size(); FilePos++)
         {
-            size_t Modified;
-            Result+=__T("<media");
-            Ztring Options=Info[FilePos]->Get(Stream_General, 0, General_CompleteName, Info_Options);
-            if (InfoOption_ShowInInform<Options.size() && Options[InfoOption_ShowInInform]==__T('Y'))
-                Result+=__T(" ref=\"")+MediaInfo_Internal::Xml_Content_Escape(Info[FilePos]->Get(Stream_General, 0, General_CompleteName), Modified)+__T("\"");
-            if (Info[FilePos] && !Info[FilePos]->ParserName.empty())
-                Result+=__T(" parser=\"")+Info[FilePos]->ParserName+=__T("\"");
-            Result+= __T('>');
-            Result+=MediaInfoLib::Config.LineSeparator_Get();
-            Result+=Info[FilePos]->Inform();
-            if (!Result.empty() && Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n'))
+            Result+=Trace_Media_Header_Get(Info[FilePos]->Get(Stream_General, 0, General_CompleteName, Info_Options), Info[FilePos]->Get(Stream_General, 0, General_CompleteName), Info[FilePos]->ParserName);
+            Inform_Append(Result, Info[FilePos], Sink);
+            if (LineSeparator_Missing(Result, Sink))
                 Result+=MediaInfoLib::Config.LineSeparator_Get();
-            Result+=__T("</media>");
-            Result+=MediaInfoLib::Config.LineSeparator_Get();
+            Result+=Trace_Media_Footer_Get();
         }
 
-        if (!Result.empty() && Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n'))
+        if (LineSeparator_Missing(Result, Sink))
             Result+=MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T("</MediaTrace");
-        Result+=__T(">")+MediaInfoLib::Config.LineSeparator_Get();
+        Result+=Trace_Footer_Get();
     }
 
     else if (MediaInfoLib::Config.Trace_Level_Get() && MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_MICRO_XML)
     {
-        Result+=__T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")+MediaInfoLib::Config.LineSeparator_Get();
-        Result+=__T('<');
-        Result+=__T("MicroMediaTrace");
-        Result+=__T(" xmlns=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace\"");
-        Result+=__T(" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"");
-        Result+=__T(" mtsl=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/micromediatrace/micromediatrace.xsd\"");
-        Result+=__T(" version=\"0.1\">");
-        Result+=__T("<creatingLibrary version=\"")+Ztring(MediaInfo_Version).SubString(__T(" - v"), Ztring())+__T("\" url=\"http")+(MediaInfoLib::Config.Https_Get()?Ztring(__T("s")):Ztring())+__T("://mediaarea.net/MediaInfo\">MediaInfoLib</creatingLibrary>");
+        Result+=Trace_Header_Get();
 
         for (size_t FilePos=0; FilePos<Info.size(); FilePos++)
         {
-            size_t Modified;
-            Result+=__T("<media");
-            Ztring Options=Info[FilePos]->Get(Stream_General, 0, General_CompleteName, Info_Options);
-            if (InfoOption_ShowInInform<Options.size() && Options[InfoOption_ShowInInform]==__T('Y'))
-                Result+=__T(" ref=\"")+MediaInfo_Internal::Xml_Content_Escape(Info[FilePos]->Get(Stream_General, 0, General_CompleteName), Modified)+__T("\"");
-            if (Info[FilePos] && !Info[FilePos]->ParserName.empty())
-                Result+=__T(" parser=\"")+Info[FilePos]->ParserName+=__T("\"");
-            Result+= __T('>');
-            Result+=Info[FilePos]->Inform();
-            Result+=__T("</media>");
+            Result+=Trace_Media_Header_Get(Info[FilePos]->Get(Stream_General, 0, General_CompleteName, Info_Options), Info[FilePos]->Get(Stream_General, 0, General_CompleteName), Info[FilePos]->ParserName);
+            Inform_Append(Result, Info[FilePos], Sink);
+            Result+=Trace_Media_Footer_Get();
         }
 
-        Result+=__T("</MicroMediaTrace>");
+        Result+=Trace_Footer_Get();
     }
 
     else if (MediaInfoLib::Config.Inform_Get()==__T("XML") || MediaInfoLib::Config.Inform_Get()==__T("MIXML"))
@@ -2319,9 +2949,9 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
         Result+=MediaInfoLib::Config.LineSeparator_Get();
 
         for (size_t FilePos=0; FilePos<Info.size(); FilePos++)
-            Result+=Info[FilePos]->Inform();
+            Inform_Append(Result, Info[FilePos], Sink);
 
-        if (!Result.empty() && Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n'))
+        if (LineSeparator_Missing(Result, Sink))
             Result+=MediaInfoLib::Config.LineSeparator_Get();
         Result+=__T("</MediaInfo");
         Result+=__T(">")+MediaInfoLib::Config.LineSeparator_Get();
@@ -2335,7 +2965,7 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
             Result+=__T("[")+MediaInfoLib::Config.LineSeparator_Get();
         for (size_t FilePos=0; FilePos<Info.size(); FilePos++)
         {
-            Result+=Info[FilePos]->Inform();
+            Inform_Append(Result, Info[FilePos], Sink);
 
             if (FilePos < Info.size() -1)
                 Result+=__T(",");
@@ -2365,7 +2995,7 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
         Result+=MediaInfo_Custom_View("Page_Begin");
         while (FilePos<Info.size())
         {
-            Result+=Info[FilePos]->Inform();
+            Inform_Append(Result, Info[FilePos], Sink);
             if (FilePos<Info.size()-1)
             {
                 Result+=MediaInfo_Custom_View("Page_Middle");
@@ -2375,7 +3005,7 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
         #if defined(MEDIAINFO_XML_YES)
         if (XML)
         {
-            if (!Result.empty() && Result[Result.size()-1]!=__T('\r') && Result[Result.size()-1]!=__T('\n'))
+            if (LineSeparator_Missing(Result, Sink))
                 Result+=MediaInfoLib::Config.LineSeparator_Get();
             Result+=__T("</");
             if (MediaInfoLib::Config.Trace_Format_Get()==MediaInfoLib::Config.Trace_Format_XML)
@@ -2416,6 +3046,12 @@ Ztring MediaInfo_Internal::Inform(std::vector<MediaInfo_Internal*>& Info)
         }
     #endif //MEDIAINFO_COMPRESS
 
+    if (Sink)
+    {
+        *Sink+=Result.To_UTF8();
+        return Ztring();
+    }
+
     return Result.c_str();
 }
 
@@ -32,6 +32,9 @@
 #include "MediaInfo/MediaInfo_Config.h"
 #include "MediaInfo/MediaInfo_Config_MediaInfo.h"
 #include "ZenLib/Thread.h"
+#if MEDIAINFO_TRACE
+    #include "ZenLib/File.h"
+#endif //MEDIAINFO_TRACE
 #if defined (MEDIAINFO_DEBUG_CONFIG) || defined (MEDIAINFO_DEBUG_BUFFER) || defined (MEDIAINFO_DEBUG_OUTPUT)
     #include <ZenLib/File.h>
     #include <map>
@@ -42,6 +45,8 @@ namespace MediaInfoLib
 {
 
 class File__Analyze;
+class Output_Sink;
+class Output_Sink_Counted;
 class Internet__Base;
 class Reader__Base;
 
@@ -79,6 +84,7 @@ public :
 
     //General information
     Ztring  Inform ();
+    Ztring  Inform (Output_Sink* Sink); //XML and JSON are written to Sink while serialized, the remaining text is returned
 #if defined(MEDIAINFO_TEXT_YES) || defined(MEDIAINFO_HTML_YES) || defined(MEDIAINFO_XML_YES) || defined(MEDIAINFO_CSV_YES) || defined(MEDIAINFO_CUSTOM_YES)
     Ztring  Inform (stream_t StreamKind, size_t StreamNumber, bool IsDirect); //All about only a specific stream
 #endif
@@ -106,6 +112,9 @@ public :
     static bool LibraryIsModified(); //Is the library has been modified? (#defines...)
     static Ztring Inform (MediaInfo_Internal* Info); // Central place for XML headers
     static Ztring Inform (std::vector<MediaInfo_Internal*> &Info); // Central place for XML headers
+    static size_t Inform (MediaInfo_Internal* Info, Output_Sink &Sink); //Same as above, written to Sink as UTF-8
+    static size_t Inform (std::vector<MediaInfo_Internal*> &Info, Output_Sink &Sink);
+    static void Inform_ConvertRetour(Ztring& Retour); //Line separators and special characters of Inform()
 
 private :
     friend class File_Bdmv;  //Theses classes need access to internal structure for optimization. There is recursivity with theses formats
@@ -137,6 +146,7 @@ private :
     MediaInfo_Internal &operator =(const MediaInfo_Internal &);
 
     static void ConvertRetour(Ztring& Retour);
+    static Ztring Inform (std::vector<MediaInfo_Internal*> &Info, Output_Sink_Counted* Sink); //Written to Sink if set
 
     //Open Buffer
     bool Info_IsMultipleParsing;
@@ -145,14 +155,37 @@ private :
     std::vector<std::vector<ZtringList> > Stream;
     std::vector<std::vector<ZtringListList> > Stream_More;
     string Details;
+    #if MEDIAINFO_TRACE
+        ZenLib::File* Trace_Stream; //File_Trace_FileName, opened once for all the parsers of this instance
+        Ztring Trace_Stream_FileName; //Set when the trace file is complete, Inform() reads the trace from it
+        int64u Trace_Stream_Body_Begin;
+        int64u Trace_Stream_Body_End;
+        void Trace_Stream_Begin(); //Writes the envelope once, then gives the file to the parser
+        void Trace_Stream_End();
+        Ztring Trace_Stream_Body_Get();
+    #endif //MEDIAINFO_TRACE
     #if MEDIAINFO_ADVANCED
         string Inform_Cache;
     #endif //MEDIAINFO_ADVANCED
     Ztring ParserName;
     void Traiter(Ztring &C); //enleve les $if...
 
+    //Results cache
+    #if MEDIAINFO_ADVANCED
+        Ztring Cache_FileName_Get (const String &File_Name, Ztring &Key);
+        bool   Cache_Load (const Ztring &Cache_FileName, const Ztring &Key);
+        void   Cache_Save (const Ztring &Cache_FileName, const Ztring &Key);
+    #endif //MEDIAINFO_ADVANCED
+
+    //IBI sidecar
+    #if MEDIAINFO_IBIUSAGE
+        void   Ibi_Sidecar_Load (const String &File_Name);
+        void   Ibi_Sidecar_Save (const String &File_Name);
+    #endif //MEDIAINFO_IBIUSAGE
+
 public :
     bool SelectFromExtension (const String &Parser); //Select File_* from the parser name
+    void Results_Move (MediaInfo_Internal* Target); //Results of the last parsing given to another instance, this one can parse another stream
     #if defined(MEDIAINFO_FILE_YES)
     void TestContinuousFileNames();
     #endif //defined(MEDIAINFO_FILE_YES)
@@ -169,6 +202,10 @@ public :
     #if defined(MEDIAINFO_XML_YES)
     static Ztring Xml_Content_Escape(const Ztring &Content, size_t &Modified);
     static Ztring &Xml_Content_Escape_Modifying(Ztring &Content, size_t &Modified);
+    static Ztring Trace_Header_Get();
+    static Ztring Trace_Footer_Get();
+    static Ztring Trace_Media_Header_Get(const Ztring &Options, const Ztring &CompleteName, const Ztring &Parser);
+    static Ztring Trace_Media_Footer_Get();
     #endif //defined(MEDIAINFO_XML_YES)
 
     #if defined(MEDIAINFO_XML_YES) || defined(MEDIAINFO_JSON_YES)
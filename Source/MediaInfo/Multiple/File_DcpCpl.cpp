@@ -431,14 +431,10 @@ bool File_DcpCpl::FileHeader_Begin()
     {
         MediaInfo_Internal MI;
         MI.Option(__T("File_KeepInfo"), __T("1"));
-        Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-        Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-        MI.Option(__T("ParseSpeed"), __T("0"));
-        MI.Option(__T("Demux"), Ztring());
+        MI.Option(__T("File_ParseSpeed"), __T("0"));
+        MI.Option(__T("File_Demux"), Ztring());
         MI.Option(__T("File_IsReferenced"), __T("1"));
         size_t MiOpenResult=MI.Open(Assetmap_FileName);
-        MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-        MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
         if (MiOpenResult
             && (MI.Get(Stream_General, 0, General_Format)==__T("DCP AM")
             || MI.Get(Stream_General, 0, General_Format)==__T("IMF AM")))
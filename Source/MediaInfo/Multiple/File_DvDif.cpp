@@ -859,13 +859,9 @@ size_t File_DvDif::Read_Buffer_Seek (size_t Method, int64u Value, int64u /*ID*/)
     {
         MediaInfo_Internal MI;
         MI.Option(__T("File_KeepInfo"), __T("1"));
-        Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-        Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-        MI.Option(__T("ParseSpeed"), __T("0"));
-        MI.Option(__T("Demux"), Ztring());
+        MI.Option(__T("File_ParseSpeed"), __T("0"));
+        MI.Option(__T("File_Demux"), Ztring());
         size_t MiOpenResult=MI.Open(File_Name);
-        MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-        MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
         if (!MiOpenResult || MI.Get(Stream_General, 0, General_Format)!=__T("DV"))
             return 0;
 
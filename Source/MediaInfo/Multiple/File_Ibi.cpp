@@ -593,12 +593,14 @@ void File_Ibi::CompressedIndex()
     const int8u* Buffer_Sav=Buffer;
     size_t Buffer_Size_Sav=Buffer_Size;
     int8u* Buffer_Temp_Sav=Buffer_Temp;
+    size_t Buffer_Temp_Begin_Sav=Buffer_Temp_Begin;
     size_t Buffer_Temp_Size_Sav=Buffer_Temp_Size;
     size_t Buffer_Offset_Sav=Buffer_Offset;
     size_t Buffer_Offset_Temp_Sav=Buffer_Offset_Temp;
     Buffer=NULL;
     Buffer_Size=0;
     Buffer_Temp=NULL;
+    Buffer_Temp_Begin=0;
     Buffer_Temp_Size=0;
     Buffer_Offset=0;
     Buffer_Offset_Temp=0;
@@ -647,6 +649,7 @@ void File_Ibi::CompressedIndex()
     Buffer=Buffer_Sav;
     Buffer_Size=Buffer_Size_Sav;
     Buffer_Temp=Buffer_Temp_Sav;
+    Buffer_Temp_Begin=Buffer_Temp_Begin_Sav;
     Buffer_Temp_Size=Buffer_Temp_Size_Sav;
     Buffer_Offset=Buffer_Offset_Sav;
     Buffer_Offset_Temp=Buffer_Offset_Temp_Sav;
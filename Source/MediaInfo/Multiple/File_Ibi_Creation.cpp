@@ -86,6 +86,7 @@ void ibi::stream::Add (const info &Info)
         {
             Infos[Infos_Pos-1].FrameNumber=Info.FrameNumber;
             Infos[Infos_Pos-1].Dts=Info.Dts;
+            Sorted_Check(Infos_Pos-1);
         }
 
         IsSynchronized=true;
@@ -98,6 +99,7 @@ void ibi::stream::Add (const info &Info)
         {
             Infos[Infos_Pos-1].FrameNumber=Info.FrameNumber;
             Infos[Infos_Pos-1].Dts=Info.Dts;
+            Sorted_Check(Infos_Pos-1);
         }
 
         IsSynchronized=true;
@@ -133,7 +135,10 @@ void ibi::stream::Add (const info &Info)
     {
         //Duplicate, updating it (in case of new frame count)
         if (IsSynchronized && Info.FrameNumber!=(int64u)-1)
+        {
             Infos[Infos_Pos].FrameNumber=Info.FrameNumber;
+            Sorted_Check(Infos_Pos);
+        }
 
         Infos_Pos++;
 
@@ -142,6 +147,7 @@ void ibi::stream::Add (const info &Info)
     }
 
     Infos.insert(Infos.begin()+Infos_Pos, Info);
+    Sorted_Check(Infos_Pos);
     Infos_Pos++;
 
     IsModified=true;
@@ -156,6 +162,54 @@ void ibi::stream::Unsynch ()
     IsSynchronized=false;
 }
 
+//---------------------------------------------------------------------------
+void ibi::stream::Sorted_Check (size_t Pos)
+{
+    //Infos are sorted by stream offset, frame number and DTS are usually in the same order but not always (unknown values, DTS discontinuities)
+    if (Pos && (Infos[Pos].FrameNumber<Infos[Pos-1].FrameNumber))
+        FrameNumber_IsSorted=false;
+    if (Pos && (Infos[Pos].Dts<Infos[Pos-1].Dts))
+        Dts_IsSorted=false;
+    if (Pos+1<Infos.size() && Infos[Pos+1].FrameNumber<Infos[Pos].FrameNumber)
+        FrameNumber_IsSorted=false;
+    if (Pos+1<Infos.size() && Infos[Pos+1].Dts<Infos[Pos].Dts)
+        Dts_IsSorted=false;
+}
+
+//---------------------------------------------------------------------------
+size_t ibi::stream::Find (int64u info::*Key, int64u Value) const
+{
+    if ((Key==&info::FrameNumber && !FrameNumber_IsSorted) || (Key==&info::Dts && !Dts_IsSorted))
+    {
+        //Not sorted, first info not before Value
+        for (size_t Pos=0; Pos<Infos.size(); Pos++)
+            if (Value<=Infos[Pos].*Key)
+            {
+                if (Value<Infos[Pos].*Key && Pos)
+                    Pos--;
+                return Pos;
+            }
+        return Infos.size();
+    }
+
+    //Sorted, binary search
+    size_t Begin=0;
+    size_t End=Infos.size();
+    while (Begin<End)
+    {
+        size_t Middle=Begin+(End-Begin)/2;
+        if (Infos[Middle].*Key<Value)
+            Begin=Middle+1;
+        else
+            End=Middle;
+    }
+
+    //Begin is the first info not before Value
+    if (Begin<Infos.size() && Begin && Value<Infos[Begin].*Key)
+        Begin--;
+    return Begin;
+}
+
 //***************************************************************************
 // Utils
 //***************************************************************************
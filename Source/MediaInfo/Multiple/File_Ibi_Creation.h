@@ -53,6 +53,8 @@ struct ibi
         bool                IsContinuous;
         bool                IsModified;
         bool                IsSynchronized;
+        bool                FrameNumber_IsSorted; //False if an info is not after the previous one, binary search is not possible
+        bool                Dts_IsSorted;
 
         stream()
         {
@@ -62,10 +64,14 @@ struct ibi
             IsContinuous=false;
             IsModified=false;
             IsSynchronized=false;
+            FrameNumber_IsSorted=true;
+            Dts_IsSorted=true;
         }
 
         void Add (const info &Info);
+        void Sorted_Check (size_t Pos);
         void Unsynch();
+        size_t Find (int64u info::*Key, int64u Value) const; //Info containing Value (StreamOffset, FrameNumber or Dts), Infos.size() if Value is after the last info
     };
     typedef std::map<int64u, stream*>   streams;
     streams                             Streams;
@@ -714,6 +714,10 @@ File_Mk::File_Mk()
     Segment_Info_Count=0;
     Segment_Tracks_Count=0;
     Segment_Cluster_Count=0;
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Offset=0;
+        Segment_Cluster_Ibi_Pending_TrackNumber=(int64u)-1;
+    #endif //MEDIAINFO_IBIUSAGE
     CurrentAttachmentIsCover=false;
     CoverIsSetFromAttachment=false;
     Laces_Pos=0;
@@ -748,6 +752,10 @@ File_Mk::~File_Mk()
 //---------------------------------------------------------------------------
 void File_Mk::Streams_Finish()
 {
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Ibi_Pending_Add();
+    #endif //MEDIAINFO_IBIUSAGE
+
     if (Duration!=0 && TimecodeScale!=0)
         Fill(Stream_General, 0, General_Duration, Duration*int64u_float64(TimecodeScale)/1000000.0, 0);
 
@@ -2577,6 +2585,10 @@ void File_Mk::Segment_Cluster()
     }
     Segment_Cluster_Count++;
     Segment_Cluster_TimeCode_Value=0; //Default
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Ibi_Pending_Add();
+        Segment_Cluster_Offset=File_Offset+Buffer_Offset-Header_Size; //Seek point for the key frames of this cluster
+    #endif //MEDIAINFO_IBIUSAGE
 }
 
 //---------------------------------------------------------------------------
@@ -2584,6 +2596,9 @@ void File_Mk::Segment_Cluster_BlockGroup()
 {
     Segment_Cluster_BlockGroup_BlockDuration_Value=(int64u)-1;
     Segment_Cluster_BlockGroup_BlockDuration_TrackNumber=(int64u)-1;
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Ibi_Pending_Add();
+    #endif //MEDIAINFO_IBIUSAGE
 }
 
 //---------------------------------------------------------------------------
@@ -2610,6 +2625,10 @@ void File_Mk::Segment_Cluster_BlockGroup_Block()
         }
     #endif // MEDIAINFO_TRACE
     streamItem.PacketCount++;
+    #if MEDIAINFO_IBIUSAGE
+        if (Config_Ibi_Create && !IsSub && streamItem.StreamKind==Stream_Video && TimecodeScale && Element_Offset+3<=Element_Size)
+            Segment_Cluster_Ibi(streamItem.PacketCount-1);
+    #endif //MEDIAINFO_IBIUSAGE
     if (streamItem.Searching_Payload || streamItem.Searching_TimeStamps || streamItem.Searching_TimeStamp_Start)
     {
         //Parsing
@@ -2898,10 +2917,59 @@ void File_Mk::Segment_Cluster_SimpleBlock()
 {
     Segment_Cluster_BlockGroup_BlockDuration_Value=(int64u)-1;
     Segment_Cluster_BlockGroup_BlockDuration_TrackNumber=(int64u)-1;
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Ibi_Pending_Add();
+    #endif //MEDIAINFO_IBIUSAGE
 
     Segment_Cluster_BlockGroup_Block();
 }
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_IBIUSAGE
+void File_Mk::Segment_Cluster_Ibi(int64u FrameNumber)
+{
+    //Peeking the block header, payload parsing may be already disabled for this track
+    const int8u* Block=Buffer+Buffer_Offset+(size_t)Element_Offset;
+    bool IsSimpleBlock=Element_Code==Elements::Segment_Cluster_SimpleBlock;
+    if (IsSimpleBlock && !(Block[2]&0x80))
+        return; //Not a key frame
+    int64s TimeCode=Segment_Cluster_TimeCode_Value+BigEndian2int16s(Block);
+    if (TimeCode<0)
+        TimeCode=0;
+
+    Segment_Cluster_Ibi_Pending.StreamOffset=Segment_Cluster_Offset;
+    Segment_Cluster_Ibi_Pending.FrameNumber=FrameNumber;
+    Segment_Cluster_Ibi_Pending.Dts=((int64u)TimeCode)*TimecodeScale;
+    Segment_Cluster_Ibi_Pending_TrackNumber=TrackNumber;
+    if (IsSimpleBlock)
+        Segment_Cluster_Ibi_Pending_Add();
+    //else BlockGroup has no key frame flag, waiting for the end of the group, a ReferenceBlock means it is not a key frame
+}
+
+//---------------------------------------------------------------------------
+void File_Mk::Segment_Cluster_Ibi_Pending_Add()
+{
+    if (Segment_Cluster_Ibi_Pending_TrackNumber==(int64u)-1)
+        return;
+
+    ibi::stream* &IbiStream_Temp=Ibi.Streams[Segment_Cluster_Ibi_Pending_TrackNumber];
+    if (IbiStream_Temp==NULL)
+        IbiStream_Temp=new ibi::stream;
+    IbiStream_Temp->Add(Segment_Cluster_Ibi_Pending);
+    Segment_Cluster_Ibi_Pending_TrackNumber=(int64u)-1;
+}
+#endif //MEDIAINFO_IBIUSAGE
+
+//---------------------------------------------------------------------------
+void File_Mk::Segment_Cluster_BlockGroup_ReferenceBlock()
+{
+    UInteger_Info();
+
+    #if MEDIAINFO_IBIUSAGE
+        Segment_Cluster_Ibi_Pending_TrackNumber=(int64u)-1; //Not a key frame
+    #endif //MEDIAINFO_IBIUSAGE
+}
+
 //---------------------------------------------------------------------------
 void File_Mk::Segment_Cluster_Timecode()
 {
@@ -121,6 +121,11 @@ private :
     void Segment_Cluster_Position(){UInteger_Info();};
     void Segment_Cluster_PrevSize(){UInteger_Info();};
     void Segment_Cluster_SimpleBlock();
+    #if MEDIAINFO_IBIUSAGE
+    //Index of the video key frames (SimpleBlock with key flag, BlockGroup without ReferenceBlock) for IBI consumers, not used for seeking in this parser
+    void Segment_Cluster_Ibi(int64u FrameNumber);
+    void Segment_Cluster_Ibi_Pending_Add();
+    #endif //MEDIAINFO_IBIUSAGE
     void Segment_Cluster_BlockGroup();
     void Segment_Cluster_BlockGroup_Block();
     void Segment_Cluster_BlockGroup_Block_Lace();
@@ -131,7 +136,7 @@ private :
     void Segment_Cluster_BlockGroup_BlockAdditions_BlockMore_BlockAdditional(){Skip_XX(Element_Size, "Data");};
     void Segment_Cluster_BlockGroup_BlockDuration();
     void Segment_Cluster_BlockGroup_ReferencePriority(){UInteger_Info();};
-    void Segment_Cluster_BlockGroup_ReferenceBlock(){UInteger_Info();};
+    void Segment_Cluster_BlockGroup_ReferenceBlock();
     void Segment_Cluster_BlockGroup_ReferenceVirtual(){UInteger_Info();};
     void Segment_Cluster_BlockGroup_CodecState(){Skip_XX(Element_Size, "Data");};
     void Segment_Cluster_BlockGroup_DiscardPadding(){UInteger_Info();};
@@ -440,6 +445,11 @@ private :
     int64u  TrackVideoDisplayHeight;
     int32u  AvgBytesPerSec;
     int64u  Segment_Cluster_TimeCode_Value;
+    #if MEDIAINFO_IBIUSAGE
+    int64u  Segment_Cluster_Offset;
+    int64u  Segment_Cluster_Ibi_Pending_TrackNumber; //BlockGroup block, key frame if there is no ReferenceBlock
+    ibi::stream::info Segment_Cluster_Ibi_Pending;
+    #endif //MEDIAINFO_IBIUSAGE
     size_t  Segment_Info_Count;
     size_t  Segment_Tracks_Count;
     size_t  Segment_Cluster_Count;
@@ -332,6 +332,7 @@ File_Mpeg4::File_Mpeg4()
     FirstMdatPos=(int64u)-1;
     LastMdatPos=0;
     FirstMoovPos=(int64u)-1;
+    SampleTable_Memory=0;
     MajorBrand=0x00000000;
     IsSecondPass=false;
     IsParsing_mdat=false;
@@ -357,6 +358,7 @@ File_Mpeg4::File_Mpeg4()
 File_Mpeg4::~File_Mpeg4()
 {
     delete[] meta_iprp_ipco_Buffer;
+    Config->File_Memory_Release(SampleTable_Memory);
 }
 
 //***************************************************************************
@@ -456,6 +458,12 @@ void File_Mpeg4::Streams_Finish()
         if (Temp->second.TimeCode)
             TimeCode_Associate(Temp->first);
 
+    //Seek index
+    #if MEDIAINFO_IBIUSAGE
+        if (Config_Ibi_Create && !IsSub)
+            Streams_Finish_Ibi();
+    #endif //MEDIAINFO_IBIUSAGE
+
     //For each stream
     vector<size_t> ToDelete_StreamPos;
     streams::iterator Temp=Streams.begin();
@@ -1275,6 +1283,10 @@ void File_Mpeg4::Streams_Finish()
             Fill(Stream_Audio, StreamPos_Last, Audio_ChannelLayout, Mpeg4_chan_Layout(101));
         }
 
+        //Memory budget
+        if (Temp->second.stss_Known_End!=(int64u)-1)
+            Fill(StreamKind_Last, StreamPos_Last, "MaxMemory_Exceeded", __T("Sync samples known up to frame ")+Ztring::ToZtring(Temp->second.stss_Known_End));
+
         //Bitrate Mode
         if (StreamKind_Last!=Stream_Menu && Retrieve(StreamKind_Last, StreamPos_Last, "BitRate_Mode").empty())
         {
@@ -1468,6 +1480,77 @@ void File_Mpeg4::Streams_Finish()
     Streams_Finish_CommercialNames();
 }
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_IBIUSAGE
+void File_Mpeg4::Streams_Finish_Ibi()
+{
+    //Sync samples of video streams, from the sample tables so mdat does not need to be scanned
+    for (streams::iterator Stream=Streams.begin(); Stream!=Streams.end(); ++Stream)
+    {
+        if (Stream->second.StreamKind!=Stream_Video || Stream->second.stco.empty() || Stream->second.stts_Durations.empty() || !Stream->second.mdhd_TimeScale)
+            continue;
+
+        ibi::stream* &IbiStream_Temp=Ibi.Streams[Stream->first];
+        if (IbiStream_Temp==NULL)
+            IbiStream_Temp=new ibi::stream;
+        IbiStream_Temp->Unsynch();
+
+        const std::vector<int64u> &Stss=Stream->second.stss; //Empty if all samples are sync samples
+        size_t Stss_Pos=0;
+        stream::stts_durations::iterator Stts_Duration=Stream->second.stts_Durations.begin();
+        int64u SamplePos=0;
+        for (size_t Stsc_Pos=0; Stsc_Pos<Stream->second.stsc.size(); Stsc_Pos++)
+        {
+            const stream::stsc_struct &Stsc=Stream->second.stsc[Stsc_Pos];
+            if (!Stsc.FirstChunk)
+                break; //Invalid, first chunk is number 1
+            size_t stco_End=(Stsc_Pos+1<Stream->second.stsc.size())?((size_t)Stream->second.stsc[Stsc_Pos+1].FirstChunk-1):Stream->second.stco.size();
+            if (stco_End>Stream->second.stco.size())
+                stco_End=Stream->second.stco.size();
+            for (size_t stco_Pos=Stsc.FirstChunk-1; stco_Pos<stco_End; stco_Pos++)
+            {
+                //Sync sample in this chunk
+                int64u Chunk_FirstSample=SamplePos;
+                int64u FrameNumber=(int64u)-1;
+                if (Stss.empty())
+                    FrameNumber=SamplePos;
+                else
+                {
+                    while (Stss_Pos<Stss.size() && Stss[Stss_Pos]<SamplePos)
+                        Stss_Pos++;
+                    if (Stss_Pos<Stss.size() && Stss[Stss_Pos]<SamplePos+Stsc.SamplesPerChunk)
+                        FrameNumber=Stss[Stss_Pos];
+                }
+                SamplePos+=Stsc.SamplesPerChunk;
+                if (FrameNumber==(int64u)-1)
+                    continue;
+
+                //Offset of the sync sample, after the samples before it in the chunk
+                int64u StreamOffset=Stream->second.stco[stco_Pos];
+                if (Stream->second.stsz_Sample_Size)
+                    StreamOffset+=(FrameNumber-Chunk_FirstSample)*Stream->second.stsz_Sample_Size*Stream->second.stsz_Sample_Multiplier;
+                else if (FrameNumber<=Stream->second.stsz_Total.size())
+                {
+                    for (size_t stsz_Pos=(size_t)Chunk_FirstSample; stsz_Pos<(size_t)FrameNumber; stsz_Pos++)
+                        StreamOffset+=Stream->second.stsz_Total[stsz_Pos];
+                }
+                else
+                    continue; //Sample sizes were not all kept
+
+                while (Stts_Duration+1!=Stream->second.stts_Durations.end() && FrameNumber>=Stts_Duration->Pos_End)
+                    ++Stts_Duration;
+                ibi::stream::info IbiInfo;
+                IbiInfo.StreamOffset=StreamOffset;
+                IbiInfo.FrameNumber=FrameNumber;
+                IbiInfo.Dts=TimeCode_DtsOffset+(Stts_Duration->DTS_Begin+((int64u)Stts_Duration->SampleDuration)*(FrameNumber-Stts_Duration->Pos_Begin))*1000000000/Stream->second.mdhd_TimeScale;
+                IbiStream_Temp->Add(IbiInfo);
+            }
+        }
+        IbiStream_Temp->Unsynch();
+    }
+}
+#endif //MEDIAINFO_IBIUSAGE
+
 //---------------------------------------------------------------------------
 void File_Mpeg4::Streams_Finish_CommercialNames()
 {
@@ -1691,17 +1774,16 @@ size_t File_Mpeg4::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                                 case Stream_Text  :
                                                     {
                                                         //Searching the corresponding chunk offset
-                                                        std::vector<int64u>::iterator Stco=Stream->second.stco.begin();
-                                                        if (Value<*Stco)
+                                                        const stream::sample_table &Stco=Stream->second.stco;
+                                                        if (Value<Stco[0])
                                                             return Read_Buffer_Seek(3, 0, ID);
 
-                                                        for (; Stco!=Stream->second.stco.end(); ++Stco)
+                                                        for (size_t Stco_Pos=0; Stco_Pos<Stco.size(); Stco_Pos++)
                                                         {
-                                                            std::vector<int64u>::iterator Stco_Next=Stco; ++Stco_Next;
-                                                            if (Stco_Next!=Stream->second.stco.end() && Value>=*Stco && Value<*Stco_Next)
+                                                            if (Stco_Pos+1<Stco.size() && Value>=Stco[Stco_Pos] && Value<Stco[Stco_Pos+1])
                                                             {
-                                                                if (JumpTo>*Stco)
-                                                                    JumpTo=*Stco;
+                                                                if (JumpTo>Stco[Stco_Pos])
+                                                                    JumpTo=Stco[Stco_Pos];
                                                                 break;
                                                             }
                                                         }
@@ -1764,6 +1846,8 @@ size_t File_Mpeg4::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                                                                                 FrameNumber=Stream->second.stss[Pos-1];
                                                                             break;
                                                                         }
+                                                                    if (FrameNumber>=Stream->second.stss_Known_End && FrameNumber>Stream->second.stss.back())
+                                                                        FrameNumber=Stream->second.stss.back(); //Last known sync sample
                                                                 }
 
                                                                 //Searching the corresponding stco
@@ -1841,6 +1925,8 @@ size_t File_Mpeg4::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                                         Value=Stream->second.stss[Pos-1];
                                     break;
                                 }
+                            if (Value>=Stream->second.stss_Known_End && Value>Stream->second.stss.back())
+                                Value=Stream->second.stss.back(); //Last known sync sample
                         }
 
                         //Searching the corresponding stco
@@ -1911,6 +1997,32 @@ void File_Mpeg4::Read_Buffer_Init()
         FrameCount_MaxPerStream=512;
 }
 
+//---------------------------------------------------------------------------
+int64u File_Mpeg4::SampleTable_Reserve(int64u Count, size_t Entry_Size, bool WithSampledCopy)
+{
+    //Count of entries to keep, tables are sampled as with a lower ParseSpeed once the memory budget is exceeded
+    int64u Size=Count;
+    if (WithSampledCopy)
+        Size+=Count<FrameCount_MaxPerStream?Count:FrameCount_MaxPerStream; //e.g. stsz, first entries of stsz_Total
+    Size*=Entry_Size;
+    if (Config->File_Memory_Reserve(Size))
+    {
+        SampleTable_Memory+=Size;
+        return Count;
+    }
+
+    if (FrameCount_MaxPerStream>512)
+        FrameCount_MaxPerStream=512;
+    if (Count>FrameCount_MaxPerStream)
+        Count=FrameCount_MaxPerStream;
+    Size=Count*Entry_Size;
+    if (WithSampledCopy)
+        Size*=2;
+    Config->File_Memory_Add(Size); //Sampled tables are kept in all cases
+    SampleTable_Memory+=Size;
+    return Count;
+}
+
 //***************************************************************************
 // Buffer
 //***************************************************************************
@@ -2129,6 +2241,73 @@ struct stream_temp
     }
 };
 
+//---------------------------------------------------------------------------
+void File_Mpeg4::stream::sample_table::resize(size_t Count, int64u Value)
+{
+    if (Value>Width_Max())
+        Widen(Value);
+    switch (Width)
+    {
+        case 1 : Data1.resize(Count, (int8u)Value); break;
+        case 2 : Data2.resize(Count, (int16u)Value); break;
+        case 4 : Data4.resize(Count, (int32u)Value); break;
+        default: Data8.resize(Count, Value);
+    }
+}
+
+//---------------------------------------------------------------------------
+void File_Mpeg4::stream::sample_table::reserve(size_t Count)
+{
+    switch (Width)
+    {
+        case 1 : Data1.reserve(Count); break;
+        case 2 : Data2.reserve(Count); break;
+        case 4 : Data4.reserve(Count); break;
+        default: Data8.reserve(Count);
+    }
+}
+
+//---------------------------------------------------------------------------
+void File_Mpeg4::stream::sample_table::Widen(int64u Value)
+{
+    int8u NewWidth;
+    if (Value<=0xFFFF)
+        NewWidth=2;
+    else if (Value<=0xFFFFFFFF)
+        NewWidth=4;
+    else
+        NewWidth=8;
+    if (NewWidth<=Width)
+        return;
+
+    //Copy of the current values with the new width, then release of the previous storage
+    size_t Count=size();
+    switch (NewWidth)
+    {
+        case 2 : Data2.reserve(Count); break;
+        case 4 : Data4.reserve(Count); break;
+        default: Data8.reserve(Count);
+    }
+    for (size_t Pos=0; Pos<Count; Pos++)
+    {
+        int64u Temp=(*this)[Pos];
+        switch (NewWidth)
+        {
+            case 2 : Data2.push_back((int16u)Temp); break;
+            case 4 : Data4.push_back((int32u)Temp); break;
+            default: Data8.push_back(Temp);
+        }
+    }
+    switch (Width)
+    {
+        case 1 : std::vector<int8u>().swap(Data1); break;
+        case 2 : std::vector<int16u>().swap(Data2); break;
+        case 4 : std::vector<int32u>().swap(Data4); break;
+        default: ;
+    }
+    Width=NewWidth;
+}
+
 //---------------------------------------------------------------------------
 #if MEDIAINFO_DEMUX
 void File_Mpeg4::stream::SplitAudio(File_Mpeg4::stream& Video, int32u moov_mvhd_TimeScale)
@@ -2177,7 +2356,7 @@ void File_Mpeg4::stream::SplitAudio(File_Mpeg4::stream& Video, int32u moov_mvhd_
         return;
 
     std::vector<stsc_struct> NewStsc;
-    std::vector<int64u> NewStsz;
+    sample_table NewStsz;
     std::vector<stts_struct> NewStts;
 
     for (;;)
@@ -2418,10 +2597,12 @@ bool File_Mpeg4::BookMark_Needed()
                 #endif //MEDIAINFO_DEMUX
                     if (!Temp->second.stco.empty() && !Temp->second.stsc.empty())
                 {
-                    int64u* stco_Current = &Temp->second.stco[0];
-                    int64u* stco_Max = stco_Current + Temp->second.stco.size();
-                    int64u* stsz_Current = Temp->second.stsz.empty()?NULL:&Temp->second.stsz[0];
-                    int64u* stsz_Max = stsz_Current + Temp->second.stsz.size();
+                    const stream::sample_table& stco = Temp->second.stco;
+                    size_t stco_Current = 0;
+                    size_t stco_Max = stco.size();
+                    const stream::sample_table& stsz = Temp->second.stsz;
+                    size_t stsz_Current = 0;
+                    size_t stsz_Max = stsz.size();
                     stream::stsc_struct* stsc_Current = &Temp->second.stsc[0];
                     stream::stsc_struct* stsc_Max = stsc_Current + Temp->second.stsc.size();
                     #if MEDIAINFO_DEMUX
@@ -2431,10 +2612,10 @@ bool File_Mpeg4::BookMark_Needed()
                     for (; stco_Current<stco_Max; ++stco_Current)
                     {
                         #if MEDIAINFO_DEMUX
-                            if (MinimalOffset>*stco_Current)
-                                MinimalOffset = *stco_Current;
-                            if (MaximalOffset < *stco_Current)
-                                MaximalOffset = *stco_Current;
+                            if (MinimalOffset>stco[stco_Current])
+                                MinimalOffset = stco[stco_Current];
+                            if (MaximalOffset < stco[stco_Current])
+                                MaximalOffset = stco[stco_Current];
                         #endif //MEDIAINFO_DEMUX
 
                         while (stsc_Current + 1 < stsc_Max && Chunk_Number >= (stsc_Current + 1)->FirstChunk)
@@ -2445,14 +2626,14 @@ bool File_Mpeg4::BookMark_Needed()
                             //Each sample has its own size
                             int64u Chunk_Offset = 0;
                             for (size_t Pos = 0; Pos < stsc_Current->SamplesPerChunk; Pos++)
-                                if (*stsz_Current)
+                                if (stsz[stsz_Current])
                                 {
                                     mdat_Pos_Type mdat_Pos_Temp2;
-                                    mdat_Pos_Temp2.Offset = *stco_Current + Chunk_Offset;
+                                    mdat_Pos_Temp2.Offset = stco[stco_Current] + Chunk_Offset;
                                     mdat_Pos_Temp2.StreamID = Temp->first;
-                                    mdat_Pos_Temp2.Size = *stsz_Current;
+                                    mdat_Pos_Temp2.Size = stsz[stsz_Current];
                                     mdat_Pos.push_back(mdat_Pos_Temp2);
-                                    Chunk_Offset += *stsz_Current;
+                                    Chunk_Offset += stsz[stsz_Current];
                                     stsz_Current++;
                                     if (stsz_Current >= stsz_Max)
                                         break;
@@ -2464,7 +2645,7 @@ bool File_Mpeg4::BookMark_Needed()
                         {
                             //Same size per sample, but granularity is too small
                             mdat_Pos_Type mdat_Pos_Temp2;
-                            mdat_Pos_Temp2.Offset = *stco_Current;
+                            mdat_Pos_Temp2.Offset = stco[stco_Current];
                             mdat_Pos_Temp2.StreamID = Temp->first;
                             mdat_Pos_Temp2.Size = stsc_Current->SamplesPerChunk*Temp->second.stsz_Sample_Size*Temp->second.stsz_Sample_Multiplier;
                             mdat_Pos.push_back(mdat_Pos_Temp2);
@@ -2502,7 +2683,7 @@ bool File_Mpeg4::BookMark_Needed()
                                     break; //Coherency issues
                                 }
                                 mdat_Pos_Type mdat_Pos_Temp2;
-                                mdat_Pos_Temp2.Offset = *stco_Current + Chunk_Offset;
+                                mdat_Pos_Temp2.Offset = stco[stco_Current] + Chunk_Offset;
                                 mdat_Pos_Temp2.StreamID = Temp->first;
                                 mdat_Pos_Temp2.Size = Size;
                                 mdat_Pos.push_back(mdat_Pos_Temp2);
@@ -31,6 +31,9 @@ protected :
     void Streams_Accept();
     void Streams_Finish();
     void Streams_Finish_CommercialNames ();
+    #if MEDIAINFO_IBIUSAGE
+    void Streams_Finish_Ibi ();
+    #endif //MEDIAINFO_IBIUSAGE
 
 public :
     File_Mpeg4();
@@ -40,6 +43,7 @@ private :
     //Buffer - Global
     void Read_Buffer_Init();
     void Read_Buffer_Unsynched();
+    int64u SampleTable_Reserve(int64u Count, size_t Entry_Size, bool WithSampledCopy=false);
     #if MEDIAINFO_SEEK
     size_t Read_Buffer_Seek (size_t Method, int64u Value, int64u ID);
     #endif //MEDIAINFO_SEEK
@@ -381,6 +385,7 @@ private :
     int64u                                  FirstMoovPos;
     int64u                                  moof_base_data_offset;
     int32u                                  FrameCount_MaxPerStream;
+    int64u                                  SampleTable_Memory; //Accounted against File_MaxMemory, released with the parser
     bool                                    data_offset_present;
     int64u                                  moof_traf_base_data_offset;
     int32u                                  moof_traf_default_sample_duration;
@@ -426,17 +431,40 @@ private :
             int32u  Rate;
         };
         std::vector<edts_struct> edts;
-        std::vector<int64u>     stco;
+        class sample_table //Values stored with the smallest width able to hold all of them (1, 2, 4 or 8 bytes)
+        {
+        public:
+            sample_table() : Width(1) {}
+
+            size_t  size() const                    {switch (Width) {case 1: return Data1.size(); case 2: return Data2.size(); case 4: return Data4.size(); default: return Data8.size();}}
+            bool    empty() const                   {return !size();}
+            int64u  operator [] (size_t Pos) const  {switch (Width) {case 1: return Data1[Pos]; case 2: return Data2[Pos]; case 4: return Data4[Pos]; default: return Data8[Pos];}}
+            void    push_back(int64u Value)         {if (Value>Width_Max()) Widen(Value); switch (Width) {case 1: Data1.push_back((int8u)Value); break; case 2: Data2.push_back((int16u)Value); break; case 4: Data4.push_back((int32u)Value); break; default: Data8.push_back(Value);}}
+            void    resize(size_t Count, int64u Value=0);
+            void    reserve(size_t Count);
+            void    clear()                         {Data1.clear(); Data2.clear(); Data4.clear(); Data8.clear(); Width=1;}
+
+        private:
+            std::vector<int8u>  Data1;
+            std::vector<int16u> Data2;
+            std::vector<int32u> Data4;
+            std::vector<int64u> Data8;
+            int8u               Width;
+            int64u  Width_Max() const               {return Width==8?(int64u)-1:((((int64u)1)<<(Width*8))-1);}
+            void    Widen(int64u Value);
+        };
+        sample_table            stco;
         struct stsc_struct
         {
             int32u FirstChunk;
             int32u SamplesPerChunk;
         };
         std::vector<stsc_struct> stsc;
-        std::vector<int64u>     stsz;
-        std::vector<int64u>     stsz_Total; //TODO: merge with stsz
+        sample_table            stsz;
+        sample_table            stsz_Total; //TODO: merge with stsz
         int64u                  stsz_StreamSize; //TODO: merge with stsz
         std::vector<int64u>     stss; //Sync Sample, base=0
+        int64u                  stss_Known_End; //Sync samples are not known from this sample (memory budget exceeded), (int64u)-1 if stss is complete
         struct stts_struct
         {
             int32u SampleCount;
@@ -524,6 +552,7 @@ private :
             stsz_StreamSize=0;
             stsz_Sample_Size=0;
             stsz_Sample_Multiplier=1;
+            stss_Known_End=(int64u)-1;
             stsz_Sample_Count=0;
             tkhd_Duration=0;
             mdhd_TimeScale=0;
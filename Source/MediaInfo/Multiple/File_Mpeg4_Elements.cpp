@@ -1849,7 +1849,7 @@ void File_Mpeg4::mdat_xxxx()
                 Stream_Temp.stts_FramePos++;
                 if (Stream_Temp.stts_FramePos>=stts_Duration->Pos_End)
                     Stream_Temp.stts_Durations_Pos++;
-                if (!Stream_Temp.stss.empty())
+                if (!Stream_Temp.stss.empty() && Frame_Count_NotParsedIncluded<Stream_Temp.stss_Known_End)
                 {
                     Demux_random_access=false;
                     for (size_t Pos=0; Pos<Stream_Temp.stss.size(); Pos++)
@@ -1860,7 +1860,7 @@ void File_Mpeg4::mdat_xxxx()
                         }
                 }
                 else
-                    Demux_random_access=true;
+                    Demux_random_access=true; //All samples are sync samples, or not known (memory budget exceeded), as without sample table
             }
             else
             {
@@ -2824,6 +2824,8 @@ void File_Mpeg4::moof_traf_trun()
     if (!sample_size_present)
         Stream->second.stsz.resize(Stream->second.stsz.size()+sample_count, moof_traf_default_sample_size);
 
+    bool stsz_Total_IsComplete=!sample_size_present || SampleTable_Reserve(sample_count, sizeof(int32u))==sample_count;
+
     if (first_sample_flags_present)
         Skip_B4(                                                "first_sample_flags");
     for (int32u Pos=0; Pos<sample_count; Pos++)
@@ -2845,7 +2847,8 @@ void File_Mpeg4::moof_traf_trun()
 
             //Filling
             Stream->second.stsz_StreamSize+=sample_size;
-            Stream->second.stsz_Total.push_back(sample_size);
+            if (stsz_Total_IsComplete || Stream->second.stsz_Total.size()<FrameCount_MaxPerStream)
+                Stream->second.stsz_Total.push_back(sample_size);
             if (Stream->second.stsz.size()<FrameCount_MaxPerStream)
                 Stream->second.stsz.push_back(sample_size);
         }
@@ -2959,12 +2962,14 @@ void File_Mpeg4::moov_cmov_cmvd_zlib()
         const int8u* Buffer_Sav=Buffer;
         size_t Buffer_Size_Sav=Buffer_Size;
         int8u* Buffer_Temp_Sav=Buffer_Temp;
+        size_t Buffer_Temp_Begin_Sav=Buffer_Temp_Begin;
         size_t Buffer_Temp_Size_Sav=Buffer_Temp_Size;
         size_t Buffer_Offset_Sav=Buffer_Offset;
         size_t Buffer_Offset_Temp_Sav=Buffer_Offset_Temp;
         Buffer=NULL;
         Buffer_Size=0;
         Buffer_Temp=NULL;
+        Buffer_Temp_Begin=0;
         Buffer_Temp_Size=0;
         Buffer_Offset=0;
         Buffer_Offset_Temp=0;
@@ -2995,6 +3000,7 @@ void File_Mpeg4::moov_cmov_cmvd_zlib()
         Buffer=Buffer_Sav;
         Buffer_Size=Buffer_Size_Sav;
         Buffer_Temp=Buffer_Temp_Sav;
+        Buffer_Temp_Begin=Buffer_Temp_Begin_Sav;
         Buffer_Temp_Size=Buffer_Temp_Size_Sav;
         Buffer_Offset=Buffer_Offset_Sav;
         Buffer_Offset_Temp=Buffer_Offset_Temp_Sav;
@@ -4533,9 +4539,10 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_co64()
     if (Count==0)
         return;
 
-    std::vector<int64u> &stco=Streams[moov_trak_tkhd_TrackID].stco;
-    stco.resize(Count<FrameCount_MaxPerStream?Count:FrameCount_MaxPerStream);
-    int64u* stco_Data=&stco[0];
+    int64u Count_Max=SampleTable_Reserve(Count<FrameCount_MaxPerStream?Count:FrameCount_MaxPerStream, sizeof(int64u));
+    stream::sample_table &stco=Streams[moov_trak_tkhd_TrackID].stco;
+    stco.clear();
+    stco.reserve((size_t)Count_Max);
 
     for (int32u Pos=0; Pos<Count; Pos++)
     {
@@ -4550,11 +4557,8 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_co64()
         Offset=BigEndian2int64u(Buffer+Buffer_Offset+(size_t)Element_Offset);
         Element_Offset+=8;
 
-        if (Pos<FrameCount_MaxPerStream)
-        {
-            (*stco_Data)=Offset;
-            stco_Data++;
-        }
+        if (Pos<Count_Max)
+            stco.push_back(Offset);
     }
 }
 
@@ -4614,6 +4618,7 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stco()
 
     int32u Count, Offset;
     Get_B4 (Count,                                              "Number of entries");
+    int64u Count_Max=SampleTable_Reserve(Count<FrameCount_MaxPerStream?Count:FrameCount_MaxPerStream, sizeof(int32u));
     for (int32u Pos=0; Pos<Count; Pos++)
     {
         //Too much slow
@@ -4627,7 +4632,7 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stco()
         Offset=BigEndian2int32u(Buffer+Buffer_Offset+(size_t)Element_Offset);
         Element_Offset+=4;
 
-        if (Pos<FrameCount_MaxPerStream)
+        if (Pos<Count_Max)
             Streams[moov_trak_tkhd_TrackID].stco.push_back(Offset);
     }
 }
@@ -4655,9 +4660,11 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stps()
     //Parsing
     int32u sample_count;
     Get_B4 (sample_count,                                       "sample-count");
+    int64u stss_Max=SampleTable_Reserve(sample_count, sizeof(int64u));
 
     int32u Offset=1; //By default, begin at 1
     bool stss_PreviouslyEmpty=Streams[moov_trak_tkhd_TrackID].stss.empty();
+    int64u stss_Dropped_First=(int64u)-1;
     for (int32u Pos=0; Pos<sample_count; Pos++)
     {
         int32u sample_number;
@@ -4678,11 +4685,18 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stps()
         {
             for (size_t Pos=0; Pos<Streams[moov_trak_tkhd_TrackID].stss.size(); Pos++)
                 Streams[moov_trak_tkhd_TrackID].stss[Pos]--;
+            if (stss_Dropped_First!=(int64u)-1)
+                stss_Dropped_First--;
             Offset=0;
         }
 
-        Streams[moov_trak_tkhd_TrackID].stss.push_back(sample_number-Offset);
+        if (Pos<stss_Max)
+            Streams[moov_trak_tkhd_TrackID].stss.push_back(sample_number-Offset);
+        else if (sample_number-Offset<stss_Dropped_First)
+            stss_Dropped_First=sample_number-Offset; //Memory budget exceeded
     }
+    if (stss_Dropped_First<Streams[moov_trak_tkhd_TrackID].stss_Known_End)
+        Streams[moov_trak_tkhd_TrackID].stss_Known_End=stss_Dropped_First;
     if (!stss_PreviouslyEmpty)
         std::sort(Streams[moov_trak_tkhd_TrackID].stss.begin(), Streams[moov_trak_tkhd_TrackID].stss.end());
 }
@@ -4696,6 +4710,7 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stsc()
     int32u Count;
     stream::stsc_struct Stsc;
     Get_B4 (Count,                                              "Number of entries");
+    int64u Count_Max=SampleTable_Reserve(Count<FrameCount_MaxPerStream?Count:FrameCount_MaxPerStream, sizeof(stream::stsc_struct));
     for (int32u Pos=0; Pos<Count; Pos++)
     {
         //Too much slow
@@ -4713,7 +4728,7 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stsc()
         */
 
         //Faster
-        if (Pos<FrameCount_MaxPerStream)
+        if (Pos<Count_Max)
         {
             if (Element_Offset+12>Element_Size)
                 break; //Problem
@@ -7500,13 +7515,16 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stss()
     NAME_VERSION_FLAG("Sync Sample");
 
     Streams[moov_trak_tkhd_TrackID].stss.clear();
+    Streams[moov_trak_tkhd_TrackID].stss_Known_End=(int64u)-1;
 
     //Parsing
     int32u entry_count;
     Get_B4 (entry_count,                                        "entry-count");
+    int64u stss_Max=SampleTable_Reserve(entry_count, sizeof(int64u));
 
     int32u Offset=1; //By default, begin at 1
     bool stss_PreviouslyEmpty=Streams[moov_trak_tkhd_TrackID].stss.empty();
+    int64u stss_Dropped_First=(int64u)-1;
     for (int32u Pos=0; Pos<entry_count; Pos++)
     {
         int32u sample_number;
@@ -7527,11 +7545,18 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stss()
         {
             for (size_t Pos=0; Pos<Streams[moov_trak_tkhd_TrackID].stss.size(); Pos++)
                 Streams[moov_trak_tkhd_TrackID].stss[Pos]--;
+            if (stss_Dropped_First!=(int64u)-1)
+                stss_Dropped_First--;
             Offset=0;
         }
 
-        Streams[moov_trak_tkhd_TrackID].stss.push_back(sample_number-Offset);
+        if (Pos<stss_Max)
+            Streams[moov_trak_tkhd_TrackID].stss.push_back(sample_number-Offset);
+        else if (sample_number-Offset<stss_Dropped_First)
+            stss_Dropped_First=sample_number-Offset; //Memory budget exceeded
     }
+    if (stss_Dropped_First<Streams[moov_trak_tkhd_TrackID].stss_Known_End)
+        Streams[moov_trak_tkhd_TrackID].stss_Known_End=stss_Dropped_First;
     if (!stss_PreviouslyEmpty)
         std::sort(Streams[moov_trak_tkhd_TrackID].stss.begin(), Streams[moov_trak_tkhd_TrackID].stss.end());
 }
@@ -7598,6 +7623,7 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stsz()
     else
     {
         int32u Size;
+        int64u stsz_Total_Max=SampleTable_Reserve(Sample_Count, sizeof(int32u), true);
         /*
         if (FieldSize==4)
             BS_Begin(); //Too much slow
@@ -7636,7 +7662,8 @@ void File_Mpeg4::moov_trak_mdia_minf_stbl_stsz()
             }
 
             Stream->second.stsz_StreamSize+=Size;
-            Stream->second.stsz_Total.push_back(Size);
+            if (Pos<stsz_Total_Max)
+                Stream->second.stsz_Total.push_back(Size);
             if (Pos<FrameCount_MaxPerStream)
                 Stream->second.stsz.push_back(Size);
         }
@@ -995,13 +995,9 @@ size_t File_MpegPs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
             {
                 MediaInfo_Internal MI;
                 MI.Option(__T("File_KeepInfo"), __T("1"));
-                Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-                Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-                MI.Option(__T("ParseSpeed"), __T("0"));
-                MI.Option(__T("Demux"), Ztring());
+                MI.Option(__T("File_ParseSpeed"), __T("0"));
+                MI.Option(__T("File_Demux"), Ztring());
                 size_t MiOpenResult=MI.Open(File_Name);
-                MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                 if (!MiOpenResult)
                     return 0;
                 for (ibi::streams::iterator IbiStream_Temp=((File_MpegPs*)MI.Info)->Ibi.Streams.begin(); IbiStream_Temp!=((File_MpegPs*)MI.Info)->Ibi.Streams.end(); ++IbiStream_Temp)
@@ -1056,38 +1052,33 @@ size_t File_MpegPs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                         Value=float64_int64s(ValueF);
                     }
 
-                    for (size_t Pos=0; Pos<IbiStream_Temp->second->Infos.size(); Pos++)
+                    size_t Pos=IbiStream_Temp->second->Find(&ibi::stream::info::Dts, Value);
+                    if (Pos<IbiStream_Temp->second->Infos.size())
                     {
-                        if (Value<=IbiStream_Temp->second->Infos[Pos].Dts)
+                        //Checking continuity of Ibi
+                        if (!IbiStream_Temp->second->Infos[Pos].IsContinuous && Pos+1<IbiStream_Temp->second->Infos.size())
                         {
-                            if (Value<IbiStream_Temp->second->Infos[Pos].Dts && Pos)
-                                Pos--;
-
-                            //Checking continuity of Ibi
-                            if (!IbiStream_Temp->second->Infos[Pos].IsContinuous && Pos+1<IbiStream_Temp->second->Infos.size())
-                            {
-                                Config->Demux_IsSeeking=true;
-                                Seek_Value=Value;
-                                Seek_Value_Maximal=IbiStream_Temp->second->Infos[Pos+1].StreamOffset;
-                                Seek_ID=IbiStream_Temp->first;
-                                GoTo((IbiStream_Temp->second->Infos[Pos].StreamOffset+IbiStream_Temp->second->Infos[Pos+1].StreamOffset)/2);
-                                Open_Buffer_Unsynch();
-
-                                return 1;
-                            }
-
-                            Config->Demux_IsSeeking=false;
-                            if (!Streams[(size_t)IbiStream_Temp->first].Parsers.empty())
-                                for (size_t Parser_Pos=0; Parser_Pos<Streams[(size_t)IbiStream_Temp->first].Parsers.size(); Parser_Pos++)
-                                    Streams[(size_t)IbiStream_Temp->first].Parsers[Parser_Pos]->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-                            else
-                                Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-
-                            GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                            Config->Demux_IsSeeking=true;
+                            Seek_Value=Value;
+                            Seek_Value_Maximal=IbiStream_Temp->second->Infos[Pos+1].StreamOffset;
+                            Seek_ID=IbiStream_Temp->first;
+                            GoTo((IbiStream_Temp->second->Infos[Pos].StreamOffset+IbiStream_Temp->second->Infos[Pos+1].StreamOffset)/2);
                             Open_Buffer_Unsynch();
 
                             return 1;
                         }
+
+                        Config->Demux_IsSeeking=false;
+                        if (!Streams[(size_t)IbiStream_Temp->first].Parsers.empty())
+                            for (size_t Parser_Pos=0; Parser_Pos<Streams[(size_t)IbiStream_Temp->first].Parsers.size(); Parser_Pos++)
+                                Streams[(size_t)IbiStream_Temp->first].Parsers[Parser_Pos]->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        else
+                            Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+
+                        GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
+
+                        return 1;
                     }
 
                     return 2; //Invalid value
@@ -1106,24 +1097,19 @@ size_t File_MpegPs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                     if (IbiStream_Temp==Ibi.Streams.end() || IbiStream_Temp->second->Infos.empty())
                         return 5; //Invalid ID
 
-                    for (size_t Pos=0; Pos<IbiStream_Temp->second->Infos.size(); Pos++)
+                    size_t Pos=IbiStream_Temp->second->Find(&ibi::stream::info::FrameNumber, Value);
+                    if (Pos<IbiStream_Temp->second->Infos.size())
                     {
-                        if (Value<=IbiStream_Temp->second->Infos[Pos].FrameNumber)
-                        {
-                            if (Value<IbiStream_Temp->second->Infos[Pos].FrameNumber && Pos)
-                                Pos--;
-
-                            if (!Streams[(size_t)IbiStream_Temp->first].Parsers.empty())
-                                for (size_t Parser_Pos=0; Parser_Pos<Streams[(size_t)IbiStream_Temp->first].Parsers.size(); Parser_Pos++)
-                                    Streams[(size_t)IbiStream_Temp->first].Parsers[Parser_Pos]->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-                            else
-                                Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        if (!Streams[(size_t)IbiStream_Temp->first].Parsers.empty())
+                            for (size_t Parser_Pos=0; Parser_Pos<Streams[(size_t)IbiStream_Temp->first].Parsers.size(); Parser_Pos++)
+                                Streams[(size_t)IbiStream_Temp->first].Parsers[Parser_Pos]->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        else
+                            Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
 
-                            GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
-                            Open_Buffer_Unsynch();
+                        GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
 
-                            return 1;
-                        }
+                        return 1;
                     }
 
                     return 2; //Invalid value
@@ -297,6 +297,11 @@ File_MpegTs::File_MpegTs()
 
 File_MpegTs::~File_MpegTs ()
 {
+    #if defined(MEDIAINFO_MPEGTS_PCR_YES) && MEDIAINFO_ADVANCED
+        for (size_t Pos=0; Complete_Stream && Pos<Complete_Stream->Streams.size(); Pos++)
+            if (Complete_Stream->Streams[Pos])
+                Config->File_Memory_Release(Complete_Stream->Streams[Pos]->TimeStamp_Intermediate.size()*sizeof(int64u));
+    #endif //defined(MEDIAINFO_MPEGTS_PCR_YES) && MEDIAINFO_ADVANCED
     delete Complete_Stream; Complete_Stream=NULL;
 }
 
@@ -1474,9 +1479,7 @@ bool File_MpegTs::Synchronize()
         && Buffer[Buffer_Offset+188*15+BDAV_Size*16+TSP_Size*15]==0x47))
     {
         Buffer_Offset++;
-        while (       Buffer_Offset+BDAV_Size+1<=Buffer_Size
-            && Buffer[Buffer_Offset+BDAV_Size]!=0x47)
-            Buffer_Offset++;
+        Synchronize_Byte(0x47, BDAV_Size, BDAV_Size+1);
     }
 
     if (Buffer_Offset+188*16+BDAV_Size*16+TSP_Size*16>=Buffer_Size
@@ -1859,8 +1862,18 @@ void File_MpegTs::Header_Parse_Events_Duration_Helper(int64u& program_clock_refe
                        TimeToAdd=float64_int64s(Bytes*8/Complete_Stream->Streams[pid]->TimeStamp_InstantaneousBitRate_Current_Raw*27000000);
                    else
                        TimeToAdd=0;
-                   Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(Complete_Stream->Streams[pid]->TimeStamp_End+TimeToAdd);
-                   Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(program_clock_reference);
+                   if (!Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped && Config->File_Memory_Reserve(2*sizeof(int64u)))
+                   {
+                       Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(Complete_Stream->Streams[pid]->TimeStamp_End+TimeToAdd);
+                       Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(program_clock_reference);
+                   }
+                   else if (!Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped)
+                   {
+                       //Memory budget exceeded, an incomplete list would give a wrong duration
+                       Config->File_Memory_Release(Complete_Stream->Streams[pid]->TimeStamp_Intermediate.size()*sizeof(int64u));
+                       std::vector<int64u>().swap(Complete_Stream->Streams[pid]->TimeStamp_Intermediate);
+                       Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped=true;
+                   }
                 }
             #endif // MEDIAINFO_ADVANCED
         }
@@ -2158,16 +2171,12 @@ size_t File_MpegTs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
             {
                 MediaInfo_Internal MI;
                 MI.Option(__T("File_KeepInfo"), __T("1"));
-                Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-                Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-                MI.Option(__T("ParseSpeed"), __T("0"));
-                MI.Option(__T("Demux"), Ztring());
+                MI.Option(__T("File_ParseSpeed"), __T("0"));
+                MI.Option(__T("File_Demux"), Ztring());
                 Config->File_Names.Separator_Set(0, ",");
                 Ztring File_Names=Config->File_Names.Read();
                 MI.Option(__T("File_FileNameFormat"), __T("CSV"));
                 size_t MiOpenResult=MI.Open(File_Names);
-                MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                 if (!MiOpenResult)
                     return (size_t)-1;
                 for (ibi::streams::iterator IbiStream_Temp=((File_MpegTs*)MI.Info)->Ibi.Streams.begin(); IbiStream_Temp!=((File_MpegTs*)MI.Info)->Ibi.Streams.end(); ++IbiStream_Temp)
@@ -2229,39 +2238,36 @@ size_t File_MpegTs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                         Value=float64_int64s(ValueF);
                     }
 
-                    for (size_t Pos=0; Pos<IbiStream_Temp->second->Infos.size(); Pos++)
+                    size_t Pos=IbiStream_Temp->second->Find(&ibi::stream::info::Dts, Value);
+                    if (Pos==IbiStream_Temp->second->Infos.size())
+                        Pos--; //After the last info
+                    if (Pos<IbiStream_Temp->second->Infos.size())
                     {
-                        if (Value<=IbiStream_Temp->second->Infos[Pos].Dts || Pos+1==IbiStream_Temp->second->Infos.size())
+                        //Checking continuity of Ibi
+                        if (!IbiStream_Temp->second->Infos[Pos].IsContinuous && Pos+1<IbiStream_Temp->second->Infos.size() && InfiniteLoop_Detect<8) //With infinite loop detect
                         {
-                            if (Value<IbiStream_Temp->second->Infos[Pos].Dts && Pos)
-                                Pos--;
-
-                            //Checking continuity of Ibi
-                            if (!IbiStream_Temp->second->Infos[Pos].IsContinuous && Pos+1<IbiStream_Temp->second->Infos.size() && InfiniteLoop_Detect<8) //With infinite loop detect
-                            {
-                                InfiniteLoop_Detect++;
-                                Config->Demux_IsSeeking=true;
-                                Seek_Value=Value;
-                                Seek_Value_Maximal=IbiStream_Temp->second->Infos[Pos+1].StreamOffset;
-                                Seek_ID=IbiStream_Temp->first;
-                                GoTo((IbiStream_Temp->second->Infos[Pos].StreamOffset+IbiStream_Temp->second->Infos[Pos+1].StreamOffset)/2);
-                                Open_Buffer_Unsynch();
-
-                                return 1;
-                            }
-
-                            InfiniteLoop_Detect=0;
-                            Config->Demux_IsSeeking=false;
-                            if (Complete_Stream && Complete_Stream->Streams[(size_t)IbiStream_Temp->first] && Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser)
-                                Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-                            else
-                                Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-
-                            GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                            InfiniteLoop_Detect++;
+                            Config->Demux_IsSeeking=true;
+                            Seek_Value=Value;
+                            Seek_Value_Maximal=IbiStream_Temp->second->Infos[Pos+1].StreamOffset;
+                            Seek_ID=IbiStream_Temp->first;
+                            GoTo((IbiStream_Temp->second->Infos[Pos].StreamOffset+IbiStream_Temp->second->Infos[Pos+1].StreamOffset)/2);
                             Open_Buffer_Unsynch();
 
                             return 1;
                         }
+
+                        InfiniteLoop_Detect=0;
+                        Config->Demux_IsSeeking=false;
+                        if (Complete_Stream && Complete_Stream->Streams[(size_t)IbiStream_Temp->first] && Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser)
+                            Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        else
+                            Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+
+                        GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
+
+                        return 1;
                     }
 
                     return 2; //Invalid value
@@ -2287,24 +2293,21 @@ size_t File_MpegTs::Read_Buffer_Seek (size_t Method, int64u Value, int64u ID)
                             return 5; //Invalid ID
                     }
 
-                    for (size_t Pos=0; Pos<IbiStream_Temp->second->Infos.size(); Pos++)
+                    size_t Pos=IbiStream_Temp->second->Find(&ibi::stream::info::FrameNumber, Value);
+                    if (Pos==IbiStream_Temp->second->Infos.size())
+                        Pos--; //After the last info
+                    if (Pos<IbiStream_Temp->second->Infos.size())
                     {
-                        if (Value<=IbiStream_Temp->second->Infos[Pos].FrameNumber || Pos+1==IbiStream_Temp->second->Infos.size())
-                        {
-                            if (Value<IbiStream_Temp->second->Infos[Pos].FrameNumber && Pos)
-                                Pos--;
-
-                            Config->Demux_IsSeeking=false;
-                            if (Complete_Stream && Complete_Stream->Streams[(size_t)IbiStream_Temp->first] && Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser)
-                                Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
-                            else
-                                Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        Config->Demux_IsSeeking=false;
+                        if (Complete_Stream && Complete_Stream->Streams[(size_t)IbiStream_Temp->first] && Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser)
+                            Complete_Stream->Streams[(size_t)IbiStream_Temp->first]->Parser->Unsynch_Frame_Count=IbiStream_Temp->second->Infos[Pos].FrameNumber;
+                        else
+                            Unsynch_Frame_Counts[(int16u)IbiStream_Temp->first]=IbiStream_Temp->second->Infos[Pos].FrameNumber;
 
-                            GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
-                            Open_Buffer_Unsynch();
+                        GoTo(IbiStream_Temp->second->Infos[Pos].StreamOffset);
+                        Open_Buffer_Unsynch();
 
-                            return 1;
-                        }
+                        return 1;
                     }
 
                     return 2; //Invalid value
@@ -2739,8 +2742,18 @@ void File_MpegTs::Header_Parse_AdaptationField()
                                            TimeToAdd=float64_int64s(Bytes*8/Complete_Stream->Streams[pid]->TimeStamp_InstantaneousBitRate_Current_Raw*27000000);
                                        else
                                            TimeToAdd=0;
-                                       Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(Complete_Stream->Streams[pid]->TimeStamp_End+TimeToAdd);
-                                       Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(program_clock_reference);
+                                       if (!Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped && Config->File_Memory_Reserve(2*sizeof(int64u)))
+                                       {
+                                           Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(Complete_Stream->Streams[pid]->TimeStamp_End+TimeToAdd);
+                                           Complete_Stream->Streams[pid]->TimeStamp_Intermediate.push_back(program_clock_reference);
+                                       }
+                                       else if (!Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped)
+                                       {
+                                           //Memory budget exceeded, an incomplete list would give a wrong duration
+                                           Config->File_Memory_Release(Complete_Stream->Streams[pid]->TimeStamp_Intermediate.size()*sizeof(int64u));
+                                           std::vector<int64u>().swap(Complete_Stream->Streams[pid]->TimeStamp_Intermediate);
+                                           Complete_Stream->Streams[pid]->TimeStamp_Intermediate_IsDropped=true;
+                                       }
                                     }
                                 #endif // MEDIAINFO_ADVANCED
                             }
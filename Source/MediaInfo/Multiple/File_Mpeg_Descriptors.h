@@ -360,6 +360,7 @@ struct complete_stream
                 int64u                              TimeStamp_Distance_Count;
                 int64u                              TimeStamp_HasProblems;
                 std::vector<int64u>                 TimeStamp_Intermediate;
+                bool                                TimeStamp_Intermediate_IsDropped; //Memory budget exceeded
             #endif // MEDIAINFO_ADVANCED
         #endif //MEDIAINFO_MPEGTS_PCR_YES
         int32u                                      registration_format_identifier;
@@ -429,6 +430,7 @@ struct complete_stream
                     TimeStamp_Distance_Total=0;
                     TimeStamp_Distance_Count=0;
                     TimeStamp_HasProblems=0;
+                    TimeStamp_Intermediate_IsDropped=false;
                 #endif // MEDIAINFO_ADVANCED
             #endif //MEDIAINFO_MPEGTS_PCR_YES
             registration_format_identifier=0x00000000;
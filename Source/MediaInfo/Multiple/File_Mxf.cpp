@@ -2311,6 +2311,7 @@ File_Mxf::File_Mxf()
 
     #if MEDIAINFO_SEEK
         IndexTables_Pos=0;
+        IndexTables_Entries_AreDropped=false;
         Clip_Header_Size=0;
         Clip_Begin=(int64u)-1;
         Clip_End=0;
@@ -2342,6 +2343,11 @@ File_Mxf::~File_Mxf()
         delete AcquisitionMetadata_Sony_E201_Lists[ i ];
 	
     AcquisitionMetadata_Sony_E201_Lists.clear();
+
+    #if MEDIAINFO_SEEK
+        for (size_t Pos=0; Pos<IndexTables.size(); Pos++)
+            Config->File_Memory_Release(IndexTables[Pos].Entries.size()*sizeof(indextable::entry));
+    #endif //MEDIAINFO_SEEK
 }
 
 //***************************************************************************
@@ -2384,6 +2390,12 @@ void File_Mxf::Streams_Finish()
         }
     #endif //MEDIAINFO_NEXTPACKET && defined(MEDIAINFO_REFERENCES_YES)
 
+    //Seek index
+    #if MEDIAINFO_IBIUSAGE
+        if (Config_Ibi_Create && !IsSub)
+            Streams_Finish_Ibi();
+    #endif //MEDIAINFO_IBIUSAGE
+
     //Per stream
     for (essences::iterator Essence=Essences.begin(); Essence!=Essences.end(); ++Essence)
     {
@@ -3942,6 +3954,42 @@ void File_Mxf::Streams_Finish_Locator(const int128u DescriptorUID, const int128u
     }
 }
 
+//---------------------------------------------------------------------------
+#if MEDIAINFO_IBIUSAGE
+void File_Mxf::Streams_Finish_Ibi ()
+{
+    //Random access points of VBR index tables, CBR offsets are computed without index and clip wrapping is not resumable from an offset
+    if (IbiStream==NULL || Clip_Begin!=(int64u)-1)
+        return;
+
+    IbiStream->Unsynch();
+    for (size_t Pos=0; Pos<IndexTables.size(); Pos++)
+    {
+        const indextable &IndexTable=IndexTables[Pos];
+        for (size_t Entry_Pos=0; Entry_Pos<IndexTable.Entries.size(); Entry_Pos++)
+        {
+            if (IndexTable.Entries[Entry_Pos].Type)
+                continue; //Predicted frame
+            int64u FrameNumber=IndexTable.IndexStartPosition+Entry_Pos;
+            int64u StreamOffset=IndexTable.Entries[Entry_Pos].StreamOffset+FrameNumber*SDTI_SizePerFrame;
+
+            //Calculating the byte count not included in seek information (partition, index...)
+            int64u StreamOffset_Offset=0;
+            for (size_t Partition_Pos=0; Partition_Pos<Partitions.size() && Partitions[Partition_Pos].StreamOffset<=StreamOffset_Offset+StreamOffset; Partition_Pos++)
+                StreamOffset_Offset+=Partitions[Partition_Pos].PartitionPackByteCount+Partitions[Partition_Pos].HeaderByteCount+Partitions[Partition_Pos].IndexByteCount;
+
+            ibi::stream::info IbiInfo;
+            IbiInfo.StreamOffset=StreamOffset_Offset+StreamOffset;
+            IbiInfo.FrameNumber=FrameNumber;
+            if (IndexTable.IndexEditRate)
+                IbiInfo.Dts=float64_int64s(((float64)FrameNumber)*1000000000/IndexTable.IndexEditRate);
+            IbiStream->Add(IbiInfo);
+        }
+    }
+    IbiStream->Unsynch();
+}
+#endif //MEDIAINFO_IBIUSAGE
+
 //---------------------------------------------------------------------------
 void File_Mxf::Streams_Finish_CommercialNames ()
 {
@@ -4643,13 +4691,9 @@ void File_Mxf::Read_Buffer_CheckFileModifications()
                                         F.Close();
                                         Config->File_IsNotGrowingAnymore=true;
                                         MediaInfo_Internal MI;
-                                        Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-                                        Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-                                        MI.Option(__T("ParseSpeed"), __T("0"));
-                                        MI.Option(__T("Demux"), Ztring());
+                                        MI.Option(__T("File_ParseSpeed"), __T("0"));
+                                        MI.Option(__T("File_Demux"), Ztring());
                                         size_t MiOpenResult=MI.Open(File_Name);
-                                        MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                                        MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                                         if (MiOpenResult)
                                         {
                                             Fill(Stream_General, 0, General_Format_Settings, MI.Get(Stream_General, 0, General_Format_Settings), true);
@@ -4940,14 +4984,10 @@ bool File_Mxf::DetectDuration ()
     MediaInfo_Internal MI;
     MI.Option(__T("File_IsDetectingDuration"), __T("1"));
     MI.Option(__T("File_KeepInfo"), __T("1"));
-    Ztring ParseSpeed_Save=MI.Option(__T("ParseSpeed_Get"), __T(""));
-    Ztring Demux_Save=MI.Option(__T("Demux_Get"), __T(""));
-    MI.Option(__T("ParseSpeed"), __T("0"));
-    MI.Option(__T("Demux"), Ztring());
+    MI.Option(__T("File_ParseSpeed"), __T("0"));
+    MI.Option(__T("File_Demux"), Ztring());
     MI.Option(__T("File_Mxf_ParseIndex"), __T("1"));
     size_t MiOpenResult=MI.Open(File_Name);
-    MI.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-    MI.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
     if (!MiOpenResult || MI.Get(Stream_General, 0, General_Format)!=__T("MXF"))
         return false;
     Partitions=((File_Mxf*)MI.Info)->Partitions;
@@ -10215,6 +10255,19 @@ void File_Mxf::IndexTableSegment_IndexEntryArray()
     int32u NIE, Length;
     Get_B4(NIE,                                                 "NIE");
     Get_B4(Length,                                              "Length");
+    #if MEDIAINFO_SEEK
+        //Memory budget, the index is dropped rather than being incomplete
+        bool Entries_AreStored=!IndexTables_Entries_AreDropped && Config->File_Memory_Reserve(((int64u)NIE)*sizeof(indextable::entry));
+        if (!Entries_AreStored && !IndexTables_Entries_AreDropped)
+        {
+            for (size_t Pos=0; Pos<IndexTables.size(); Pos++)
+            {
+                Config->File_Memory_Release(IndexTables[Pos].Entries.size()*sizeof(indextable::entry));
+                std::vector<indextable::entry>().swap(IndexTables[Pos].Entries);
+            }
+            IndexTables_Entries_AreDropped=true;
+        }
+    #endif //MEDIAINFO_SEEK
     for (int32u Pos=0; Pos<NIE; Pos++)
     {
         #if MEDIAINFO_SEEK
@@ -10240,7 +10293,8 @@ void File_Mxf::IndexTableSegment_IndexEntryArray()
             Get_B8 (Stream_Offset,                              "Stream Offset");
             Entry.StreamOffset=Stream_Offset;
             Entry.Type=(forward_rediction_flag?1:0)*2+(backward_prediction_flag?1:0);
-            IndexTables[IndexTables.size()-1].Entries.push_back(Entry);
+            if (Entries_AreStored)
+                IndexTables[IndexTables.size()-1].Entries.push_back(Entry);
         #else //MEDIAINFO_SEEK
             Skip_B8(                                            "Stream Offset");
         #endif //MEDIAINFO_SEEK
@@ -10285,7 +10339,10 @@ void File_Mxf::IndexTableSegment_IndexStartPosition()
                 if (IndexTables[Pos].IndexStartPosition==Data)
                 {
                     if (IndexTables[Pos].IndexDuration==1 && Pos!=IndexTables.size()-1)
+                    {
+                        Config->File_Memory_Release(IndexTables[Pos].Entries.size()*sizeof(indextable::entry));
                         IndexTables.erase(IndexTables.begin()+Pos);
+                    }
                     else
                     {
                         //Removed in order to get all indexes, even the duplicated ones (in order to check duplicated index in the footer)
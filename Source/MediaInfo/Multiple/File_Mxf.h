@@ -86,6 +86,9 @@ protected :
     void Streams_Finish_Component_ForAS11 (const int128u ComponentUID, float64 EditRate, int32u TrackID, int64s Origin);
     void Streams_Finish_Identification (const int128u IdentificationUID);
     void Streams_Finish_CommercialNames ();
+    #if MEDIAINFO_IBIUSAGE
+    void Streams_Finish_Ibi ();
+    #endif //MEDIAINFO_IBIUSAGE
 
     //Buffer - Global
     void Read_Buffer_Init ();
@@ -1367,6 +1370,7 @@ protected :
         typedef std::vector<indextable> indextables;
         indextables                     IndexTables;
         size_t                          IndexTables_Pos;
+        bool                            IndexTables_Entries_AreDropped; //Memory budget exceeded
 
         //Other
         int64u  Clip_Header_Size;
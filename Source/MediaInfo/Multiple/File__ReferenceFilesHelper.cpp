@@ -26,7 +26,11 @@
 #include "ZenLib/File.h"
 #include "ZenLib/FileName.h"
 #include "ZenLib/Format/Http/Http_Utils.h"
+#include "ZenLib/Thread.h"
+#include "ZenLib/CriticalSection.h"
+#include "MediaInfo/Condition.h"
 #include <set>
+#include <deque>
 #include <algorithm>
 #include <cfloat>
 #if MEDIAINFO_EVENTS
@@ -59,6 +63,7 @@ File__ReferenceFilesHelper::File__ReferenceFilesHelper(File__Analyze* MI_, Media
     MI=MI_;
     Config=Config_;
     Init_Done=false;
+    References_Threads=0;
     FrameRate=0;
     Duration=0;
     #if MEDIAINFO_DEMUX
@@ -403,6 +408,11 @@ void File__ReferenceFilesHelper::ParseReferences()
 {
     if (!Init_Done)
     {
+        #if MEDIAINFO_ADVANCED
+            if (!Sequences.empty())
+                Config->File_Dependencies_Unknown_Set(); //Results depend on the referenced files
+        #endif //MEDIAINFO_ADVANCED
+
         #if MEDIAINFO_FILTER
             if (MI->Config->File_Filter_Audio_Get())
             {
@@ -779,6 +789,19 @@ void File__ReferenceFilesHelper::ParseReferences()
         CountOfReferences_ForReadSize=Sequences.size();
         Init_Done=true;
 
+        //Opening referenced files in parallel, results are merged in the sequence order below
+        References_Threads=Config->File_ReferencesThreads_Get();
+        #if MEDIAINFO_NEXTPACKET
+            if (Config->NextPacket_Get())
+                References_Threads=0;
+        #endif //MEDIAINFO_NEXTPACKET
+        #if MEDIAINFO_EVENTS
+            if (Config->Event_CallBackFunction_IsSet())
+                References_Threads=0; //Events must be sent in order, from the calling thread
+        #endif //MEDIAINFO_EVENTS
+        if (References_Threads>1)
+            ParseReferences_Parallel();
+
         #if MEDIAINFO_DEMUX && MEDIAINFO_NEXTPACKET
             if (Config->NextPacket_Get() && MI->Demux_EventWasSent_Accept_Specific)
             {
@@ -899,7 +922,7 @@ void File__ReferenceFilesHelper::ParseReferences()
 }
 
 //---------------------------------------------------------------------------
-bool File__ReferenceFilesHelper::ParseReference_Init()
+void File__ReferenceFilesHelper::ParseReference_Config()
 {
     //Configuration
     Sequences[Sequences_Current]->MI=MI_Create();
@@ -926,14 +949,10 @@ bool File__ReferenceFilesHelper::ParseReference_Init()
             {
                 MediaInfo_Internal MI2;
                 MI2.Option(__T("File_KeepInfo"), __T("1"));
-                Ztring ParseSpeed_Save=MI2.Option(__T("ParseSpeed_Get"), __T("0"));
-                Ztring Demux_Save=MI2.Option(__T("Demux_Get"), __T(""));
-                MI2.Option(__T("ParseSpeed"), __T("0"));
-                MI2.Option(__T("Demux"), Ztring());
+                MI2.Option(__T("File_ParseSpeed"), __T("0"));
+                MI2.Option(__T("File_Demux"), Ztring());
                 Sequences[Sequences_Current]->Resources[Pos]->FileNames.Separator_Set(0, ",");
                 size_t MiOpenResult=MI2.Open(Sequences[Sequences_Current]->Resources[Pos]->FileNames.Read());
-                MI2.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                MI2.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                 if (MiOpenResult)
                 {
                     #if MEDIAINFO_DEMUX
@@ -987,6 +1006,15 @@ bool File__ReferenceFilesHelper::ParseReference_Init()
             #endif //MEDIAINFO_DEMUX
         }
     }
+}
+
+//---------------------------------------------------------------------------
+bool File__ReferenceFilesHelper::ParseReference_Init()
+{
+    //Configuration
+    bool IsOpened=Sequences[Sequences_Current]->MI_OpenResult!=(size_t)-1;
+    if (!IsOpened)
+        ParseReference_Config();
 
     if (Sequences[Sequences_Current]->IsCircular)
     {
@@ -1008,10 +1036,20 @@ bool File__ReferenceFilesHelper::ParseReference_Init()
     else
     {
         //Run
-        #if MEDIAINFO_EVENTS
-            SubFile_Start();
-        #endif //MEDIAINFO_EVENTS
-        if (!Sequences[Sequences_Current]->MI->Open(Sequences[Sequences_Current]->FileNames.Read()))
+        size_t MiOpenResult;
+        if (IsOpened)
+        {
+            MiOpenResult=Sequences[Sequences_Current]->MI_OpenResult;
+            Sequences[Sequences_Current]->MI_OpenResult=(size_t)-1;
+        }
+        else
+        {
+            #if MEDIAINFO_EVENTS
+                SubFile_Start();
+            #endif //MEDIAINFO_EVENTS
+            MiOpenResult=Sequences[Sequences_Current]->MI->Open(Sequences[Sequences_Current]->FileNames.Read());
+        }
+        if (!MiOpenResult)
         {
             #if MEDIAINFO_EVENTS
                 Config->Event_SubFile_Missing(Sequences[Sequences_Current]->Source);
@@ -1032,7 +1070,7 @@ bool File__ReferenceFilesHelper::ParseReference_Init()
             Sequences[Sequences_Current]->Status.set(File__Analyze::IsFinished);
         }
 
-        if (Config->ParseSpeed>=1)
+        if (Config->ParseSpeed>=1 && !IsOpened)
             for (size_t Pos=1; Pos<Sequences[Sequences_Current]->Resources.size(); Pos++)
             {
                 Sequences[Sequences_Current]->Resources[Pos]->FileNames.Separator_Set(0, ",");
@@ -1048,10 +1086,109 @@ bool File__ReferenceFilesHelper::ParseReference_Init()
     return true;
 }
 
+//---------------------------------------------------------------------------
+struct File__ReferenceFilesHelper_Queue
+{
+    CriticalSection         CS;
+    std::deque<sequence*>   Jobs_ToDo;
+    Condition               Worker_Finished;
+    size_t                  Workers_Running;
+};
+
+//---------------------------------------------------------------------------
+class File__ReferenceFilesHelper_Worker : public Thread
+{
+public:
+    File__ReferenceFilesHelper_Queue* Queue;
+    bool                    OpenResources;
+
+    void Entry()
+    {
+        for (;;)
+        {
+            sequence* Job=NULL;
+            Queue->CS.Enter();
+            if (!Queue->Jobs_ToDo.empty())
+            {
+                Job=Queue->Jobs_ToDo.front();
+                Queue->Jobs_ToDo.pop_front();
+            }
+            else
+                Queue->Workers_Running--;
+            Queue->CS.Leave();
+
+            if (!Job)
+                break;
+
+            Job->MI_OpenResult=Job->MI->Open(Job->FileNames.Read());
+            if (OpenResources)
+                for (size_t Pos=1; Pos<Job->Resources.size(); Pos++)
+                {
+                    Job->Resources[Pos]->FileNames.Separator_Set(0, ",");
+                    Job->Resources[Pos]->MI->Open(Job->Resources[Pos]->FileNames.Read());
+                }
+        }
+
+        Queue->Worker_Finished.Signal();
+    }
+};
+
+//---------------------------------------------------------------------------
+void File__ReferenceFilesHelper::ParseReferences_Parallel()
+{
+    //Configuration is done serially (it uses the offsets computed from previous sequences)
+    //Only File_ReferencesThreads sequences are opened at a time, they are released once finalized
+    File__ReferenceFilesHelper_Queue Queue;
+    size_t Sequences_Current_Save=Sequences_Current;
+    for (; Sequences_Current<Sequences.size() && Queue.Jobs_ToDo.size()<References_Threads; Sequences_Current++)
+        if (Sequences[Sequences_Current]->MI==NULL && !Sequences[Sequences_Current]->FileNames.empty() && !Sequences[Sequences_Current]->IsCircular)
+        {
+            ParseReference_Config();
+            Queue.Jobs_ToDo.push_back(Sequences[Sequences_Current]);
+        }
+    Sequences_Current=Sequences_Current_Save;
+    if (Queue.Jobs_ToDo.empty())
+        return;
+
+    //Workers
+    std::vector<File__ReferenceFilesHelper_Worker*> Workers;
+    Queue.Workers_Running=Queue.Jobs_ToDo.size();
+    for (size_t Pos=0; Pos<Queue.Workers_Running; Pos++)
+    {
+        File__ReferenceFilesHelper_Worker* Worker=new File__ReferenceFilesHelper_Worker;
+        Worker->Queue=&Queue;
+        Worker->OpenResources=Config->ParseSpeed>=1;
+        Worker->Run();
+        Workers.push_back(Worker);
+    }
+
+    //Join
+    for (;;)
+    {
+        Queue.CS.Enter();
+        bool IsDone=Queue.Workers_Running==0;
+        Queue.CS.Leave();
+        if (IsDone)
+            break;
+        Queue.Worker_Finished.Wait();
+    }
+
+    //Workers have left their loop, only the end of the thread is remaining
+    for (size_t Pos=0; Pos<Workers.size(); Pos++)
+    {
+        while (!Workers[Pos]->IsExited())
+            Thread::Yield();
+        delete Workers[Pos];
+    }
+}
+
 //---------------------------------------------------------------------------
 void File__ReferenceFilesHelper::ParseReference()
 {
-    if (Sequences[Sequences_Current]->MI==NULL && !Sequences[Sequences_Current]->FileNames.empty())
+    if (References_Threads>1 && Sequences[Sequences_Current]->MI==NULL)
+        ParseReferences_Parallel(); //Next batch of sequences
+
+    if ((Sequences[Sequences_Current]->MI==NULL || Sequences[Sequences_Current]->MI_OpenResult!=(size_t)-1) && !Sequences[Sequences_Current]->FileNames.empty())
     {
         if (!ParseReference_Init())
             return;
@@ -1286,10 +1423,8 @@ void File__ReferenceFilesHelper::ParseReference_Finalize_PerStream ()
         {
             MediaInfo_Internal MI2;
             MI2.Option(__T("File_KeepInfo"), __T("1"));
-            Ztring ParseSpeed_Save=MI2.Option(__T("ParseSpeed_Get"), __T(""));
-            Ztring Demux_Save=MI2.Option(__T("Demux_Get"), __T(""));
-            MI2.Option(__T("ParseSpeed"), __T("0"));
-            MI2.Option(__T("Demux"), Ztring());
+            MI2.Option(__T("File_ParseSpeed"), __T("0"));
+            MI2.Option(__T("File_Demux"), Ztring());
             MI2.Config.File_IgnoreEditsBefore=Sequences[Sequences_Current]->Resources[Pos]->IgnoreEditsBefore;
             if (Sequences[Sequences_Current]->Resources[Pos]->IgnoreEditsAfter==(int64u)-1 && Sequences[Sequences_Current]->Resources[Pos]->IgnoreEditsAfterDuration!=(int64u)-1)
                 MI2.Config.File_IgnoreEditsAfter=Sequences[Sequences_Current]->Resources[Pos]->IgnoreEditsBefore+Sequences[Sequences_Current]->Resources[Pos]->IgnoreEditsAfterDuration;
@@ -1298,8 +1433,6 @@ void File__ReferenceFilesHelper::ParseReference_Finalize_PerStream ()
             MI2.Config.File_EditRate=Sequences[Sequences_Current]->Resources[Pos]->EditRate;
             Sequences[Sequences_Current]->Resources[Pos]->FileNames.Separator_Set(0, ",");
             size_t MiOpenResult=MI2.Open(Sequences[Sequences_Current]->Resources[Pos]->FileNames.Read());
-            MI2.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-            MI2.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
             if (MiOpenResult)
             {
                 BitRate_Before=MI2.Get(StreamKind_Last, StreamPos_From, MI->Fill_Parameter(StreamKind_Last, Generic_BitRate)).To_float64();
@@ -1632,6 +1765,8 @@ MediaInfo_Internal* File__ReferenceFilesHelper::MI_Create()
     MI_Temp->Option(__T("File_FileNameFormat"), __T("CSV"));
     MI_Temp->Option(__T("File_KeepInfo"), __T("1"));
     MI_Temp->Option(__T("File_ID_OnlyRoot"), Config->File_ID_OnlyRoot_Get()?__T("1"):__T("0"));
+    if (Config->File_MaxMemory_Get())
+        MI_Temp->Option(__T("File_MaxMemory"), Ztring::ToZtring(Config->File_MaxMemory_Get()));
     #if defined(MEDIAINFO_DVDIF_YES)
     MI_Temp->Option(__T("File_DvDif_DisableAudioIfIsInContainer"), Config->File_DvDif_DisableAudioIfIsInContainer_Get()?__T("1"):__T("0"));
     #endif
@@ -1810,13 +1945,9 @@ size_t File__ReferenceFilesHelper::Seek (size_t Method, int64u Value, int64u ID)
 
                                 MediaInfo_Internal MI2;
                                 MI2.Option(__T("File_KeepInfo"), __T("1"));
-                                Ztring ParseSpeed_Save=MI2.Option(__T("ParseSpeed_Get"), __T(""));
-                                Ztring Demux_Save=MI2.Option(__T("Demux_Get"), __T(""));
-                                MI2.Option(__T("ParseSpeed"), __T("0"));
-                                MI2.Option(__T("Demux"), Ztring());
+                                MI2.Option(__T("File_ParseSpeed"), __T("0"));
+                                MI2.Option(__T("File_Demux"), Ztring());
                                 size_t MiOpenResult=MI2.Open(FileName);
-                                MI2.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                                MI2.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                                 if (!MiOpenResult)
                                     return (size_t)-1;
                                 Duration=MI2.Get(Stream_General, 0, General_Duration).To_float64()/1000;
@@ -1905,13 +2036,9 @@ size_t File__ReferenceFilesHelper::Seek (size_t Method, int64u Value, int64u ID)
 
                             MediaInfo_Internal MI2;
                             MI2.Option(__T("File_KeepInfo"), __T("1"));
-                            Ztring ParseSpeed_Save=MI2.Option(__T("ParseSpeed_Get"), __T(""));
-                            Ztring Demux_Save=MI2.Option(__T("Demux_Get"), __T(""));
-                            MI2.Option(__T("ParseSpeed"), __T("0"));
-                            MI2.Option(__T("Demux"), Ztring());
+                            MI2.Option(__T("File_ParseSpeed"), __T("0"));
+                            MI2.Option(__T("File_Demux"), Ztring());
                             size_t MiOpenResult=MI2.Open(FileName);
-                            MI2.Option(__T("ParseSpeed"), ParseSpeed_Save); //This is a global value, need to reset it. TODO: local value
-                            MI2.Option(__T("Demux"), Demux_Save); //This is a global value, need to reset it. TODO: local value
                             if (!MiOpenResult)
                                 return (size_t)-1;
                             Duration=MI2.Get(Stream_General, 0, General_Duration).To_float64()/1000;
@@ -65,6 +65,8 @@ public:
 private :
     //Streams management
     void ParseReference ();
+    void ParseReference_Config ();
+    void ParseReferences_Parallel ();
     void ParseReference_Finalize ();
     void ParseReference_Finalize_PerStream ();
     void Open_Buffer_Unsynch() {Read_Buffer_Unsynched();}
@@ -76,6 +78,7 @@ private :
     File__Analyze*                  MI;
     MediaInfo_Config_MediaInfo*     Config;
     bool                            Init_Done;
+    size_t                          References_Threads;
     bool                            Demux_Interleave;
     size_t                          CountOfReferencesToParse;
     size_t                          CountOfReferences_ForReadSize;
@@ -59,6 +59,7 @@ sequence::sequence()
         List_Compute_Done=false;
     #endif //MEDIAINFO_ADVANCED || MEDIAINFO_HASH
     MI=NULL;
+    MI_OpenResult=(size_t)-1;
 }
 
 //---------------------------------------------------------------------------
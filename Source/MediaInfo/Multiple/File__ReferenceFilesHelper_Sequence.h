@@ -71,6 +71,7 @@ public:
     int64u              FileSize;
     bool                FileSize_IsPresent; //TODO: merge with FileSize after regression tests
     MediaInfo_Internal* MI;
+    size_t              MI_OpenResult; //Open() already done by a worker thread, (size_t)-1 if not
     std::bitset<32> Status;
 };
 
@@ -77,16 +77,14 @@ string XML_Encode (const string& Data)
 }
 
 //---------------------------------------------------------------------------
-string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
+void To_XML (Node& Cur_Node, const int& Level, Output_Sink& Result, bool Print_Header, bool Indent)
 {
-    string Result;
-
     if (!Cur_Node.RawContent.empty())
     {
       //  if (Level)
       //      Result+="\n";
         Result+=Cur_Node.RawContent;
-        return Result;
+        return;
     }
 
     if (Print_Header)
@@ -103,7 +101,7 @@ string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
     }
 
     if (Cur_Node.Name.empty() && Cur_Node.XmlCommentOut.empty())
-        return Result;
+        return;
 
     if (Level)
         Result+="\n";
@@ -116,7 +114,7 @@ string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
         if (Cur_Node.Name.empty())
         {
             Result += " -->";
-            return Result;
+            return;
         }
         Result+="\n";
     }
@@ -139,7 +137,7 @@ string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
             Result+=" <!-- "+Cur_Node.XmlComment+" -->";
         if (Cur_Node.XmlCommentOut.size())
             Result+="\n"+(Indent?string(Level, '\t'):string())+"-->";
-        return Result;
+        return;
     }
 
     Result+=">";
@@ -163,7 +161,7 @@ string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
             if (!Cur_Node.Childs[Pos])
                 continue;
 
-            Result+=To_XML(*Cur_Node.Childs[Pos], Level+1, false, Indent);
+            To_XML(*Cur_Node.Childs[Pos], Level+1, Result, false, Indent);
             delete Cur_Node.Childs[Pos];
             Cur_Node.Childs[Pos]=NULL;
         }
@@ -180,8 +178,6 @@ string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
         Result+=" <!-- "+Cur_Node.XmlComment+" -->";
     if (!Level)
         Result+="\n";
-
-    return Result;
 }
 
 //---------------------------------------------------------------------------
@@ -206,9 +202,8 @@ string JSON_Encode (const string& Data)
 }
 
 //---------------------------------------------------------------------------
-string To_JSON_Attributes(Node& Cur_Node, const int& Level, bool Indent)
+static void To_JSON_Attributes(Node& Cur_Node, const int& Level, Output_Sink& Result, bool Indent)
 {
-    string Result;
     for (size_t Pos=0; Pos<Cur_Node.Attrs.size(); Pos++)
     {
         if (Cur_Node.Attrs[Pos].first.empty() || Cur_Node.Attrs[Pos].first.substr(0, 5)=="xmlns" || Cur_Node.Attrs[Pos].first.substr(0, 3)=="xsi")
@@ -221,15 +216,11 @@ string To_JSON_Attributes(Node& Cur_Node, const int& Level, bool Indent)
             Result+=",";
     }
     Cur_Node.Attrs.clear(); //Free memory
-
-    return Result;
 }
 
 //---------------------------------------------------------------------------
-string To_JSON_Elements(Node& Cur_Node, const int& Level, bool Indent)
+static void To_JSON_Elements(Node& Cur_Node, const int& Level, Output_Sink& Result, bool Indent)
 {
-    string Result;
-
     for (size_t Pos=0; Pos<Cur_Node.Childs.size(); Pos++)
     {
         if (!Cur_Node.Childs[Pos])
@@ -268,8 +259,8 @@ string To_JSON_Elements(Node& Cur_Node, const int& Level, bool Indent)
             else
             {
                 Result+=(Indent?string(Level+1, '\t'):string())+"{";
-                Result+=To_JSON_Attributes(*Cur_Node.Childs[Pos2], Level+2, Indent);
-                Result+=To_JSON_Elements(*Cur_Node.Childs[Pos2], Level+2, Indent);
+                To_JSON_Attributes(*Cur_Node.Childs[Pos2], Level+2, Result, Indent);
+                To_JSON_Elements(*Cur_Node.Childs[Pos2], Level+2, Result, Indent);
                 Result+="\n";
 
                 if(!Cur_Node.Childs[Pos2]->Value.empty())
@@ -293,25 +284,21 @@ string To_JSON_Elements(Node& Cur_Node, const int& Level, bool Indent)
             Result+=",";
     }
     Cur_Node.Childs.clear(); //Free memory
-
-    return Result;
 }
 
 //---------------------------------------------------------------------------
-string To_JSON (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
+void To_JSON (Node& Cur_Node, const int& Level, Output_Sink& Result, bool Print_Header, bool Indent)
 {
-    string Result;
-
     if (!Cur_Node.RawContent.empty())
     {
         if (Level)
             Result+="\n";
         Result+=Cur_Node.RawContent;
-        return Result;
+        return;
     }
 
     if (Cur_Node.Name.empty())
-        return Result;
+        return;
 
     if (Print_Header)
         Result+="{\n";
@@ -326,12 +313,12 @@ string To_JSON (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent
             Result+="\""+JSON_Encode(Cur_Node.Value)+"\"";
         if (Print_Header)
             Result+="\n}\n";
-        return Result;
+        return;
     }
 
     Result+="{";
-    Result+=To_JSON_Attributes(Cur_Node, Level+2, Indent);
-    Result+=To_JSON_Elements(Cur_Node, Level+2, Indent);
+    To_JSON_Attributes(Cur_Node, Level+2, Result, Indent);
+    To_JSON_Elements(Cur_Node, Level+2, Result, Indent);
     if (!Cur_Node.Value.empty())
         Result+="\n"+(Indent?string(Level+2, '\t'):string())+"\"#value\": \""+JSON_Encode(Cur_Node.Value)+"\"";
 
@@ -339,10 +326,60 @@ string To_JSON (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent
 
     if (Print_Header)
         Result+="\n}\n";
+}
 
+//---------------------------------------------------------------------------
+string To_XML (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
+{
+    string Result;
+    Output_Sink_String Sink(Result);
+    To_XML(Cur_Node, Level, Sink, Print_Header, Indent);
     return Result;
 }
 
+//---------------------------------------------------------------------------
+string To_JSON (Node& Cur_Node, const int& Level, bool Print_Header, bool Indent)
+{
+    string Result;
+    Output_Sink_String Sink(Result);
+    To_JSON(Cur_Node, Level, Sink, Print_Header, Indent);
+    return Result;
+}
+
+//---------------------------------------------------------------------------
+void Output_Sink_Inform::Write(const char* Data, size_t Size)
+{
+    Pending.append(Data, Size);
+
+    //Converting by blocks, up to the last complete line
+    if (Pending.size()>=64*1024)
+    {
+        size_t End=Pending.rfind('\n');
+        if (End!=string::npos)
+            Convert(End+1);
+    }
+}
+
+//---------------------------------------------------------------------------
+void Output_Sink_Inform::Flush()
+{
+    if (!Pending.empty())
+        Convert(Pending.size());
+}
+
+//---------------------------------------------------------------------------
+void Output_Sink_Inform::Convert(size_t Size)
+{
+    Ztring Block;
+    Block.From_UTF8(Pending.data(), 0, Size);
+    Pending.erase(0, Size);
+    MediaInfo_Internal::Inform_ConvertRetour(Block);
+    if (Target)
+        *Target+=Block.To_UTF8();
+    else
+        Target_Ztring+=Block;
+}
+
 //---------------------------------------------------------------------------
 bool Parse_XML(const ZtringList& Parents, const Ztring& PlaceHolder, const XMLNode* _XmlNode, Node* _Node, Node** _MI_Info, const Ztring& FileName, ZtringListList& Values)
 {
@@ -13,6 +13,8 @@
 #include "MediaInfo/MediaInfo_Internal.h"
 #include <ZenLib/Ztring.h>
 #include <string>
+#include <cstdio>
+#include <cstring>
 //---------------------------------------------------------------------------
 
 namespace MediaInfoLib
@@ -226,6 +228,84 @@ struct Node
     }
 };
 
+//Destination of the serialization, written as the tree is walked
+class Output_Sink
+{
+public:
+    virtual ~Output_Sink() {}
+    virtual void Write(const char* Data, size_t Size)=0;
+
+    Output_Sink& operator += (const std::string& Data) {Write(Data.data(), Data.size()); return *this;}
+    Output_Sink& operator += (const char* Data) {Write(Data, strlen(Data)); return *this;}
+};
+
+class Output_Sink_String : public Output_Sink
+{
+public:
+    Output_Sink_String(std::string& Target_) : Target(Target_) {}
+    void Write(const char* Data, size_t Size) {Target.append(Data, Size);}
+private:
+    std::string& Target;
+};
+
+class Output_Sink_File : public Output_Sink
+{
+public:
+    Output_Sink_File(FILE* F_) : F(F_) {}
+    void Write(const char* Data, size_t Size) {fwrite(Data, 1, Size, F);}
+private:
+    FILE* F;
+};
+
+class Output_Sink_CallBack : public Output_Sink
+{
+public:
+    typedef void (*callback)(const char* Data, size_t Size, void* UserHandler);
+    Output_Sink_CallBack(callback CallBack_, void* UserHandler_) : CallBack(CallBack_), UserHandler(UserHandler_) {}
+    void Write(const char* Data, size_t Size) {CallBack(Data, Size, UserHandler);}
+private:
+    callback CallBack;
+    void* UserHandler;
+};
+
+//Forwarding to Target, the size and the last byte written are kept
+class Output_Sink_Counted : public Output_Sink
+{
+public:
+    Output_Sink_Counted(Output_Sink& Target_) : Size(0), Last('\0'), Target(Target_) {}
+    void Write(const char* Data, size_t Data_Size)
+    {
+        if (!Data_Size)
+            return;
+        Target.Write(Data, Data_Size);
+        Size+=Data_Size;
+        Last=Data[Data_Size-1];
+    }
+    size_t Size;
+    char Last;
+private:
+    Output_Sink& Target;
+};
+
+//Inform() text conversion (line separators, special characters) done on blocks of complete lines
+//No pattern spans a line break, so the result is the same as converting the whole text at once
+class Output_Sink_Inform : public Output_Sink
+{
+public:
+    Output_Sink_Inform(ZenLib::Ztring& Target_Ztring_, Output_Sink* Target_=NULL) : Target(Target_), Target_Ztring(Target_Ztring_) {} //Written to Target if set, else appended to Target_Ztring
+    ~Output_Sink_Inform() {Flush();}
+    void Write(const char* Data, size_t Size);
+    void Flush();
+private:
+    void Convert(size_t Size);
+    Output_Sink* Target;
+    ZenLib::Ztring& Target_Ztring;
+    std::string Pending;
+};
+
+//Writing to Result while the tree is walked, nodes are freed as soon as they are written
+void To_XML (Node& Cur_Node, const int& Level, Output_Sink& Result, bool Print_Header=false, bool Indent=true);
+void To_JSON (Node& Cur_Node, const int& Level, Output_Sink& Result, bool Print_Header=false, bool Indent=true);
 std::string To_XML (Node& Cur_Node, const int& Level, bool Print_Header=false, bool Indent=true);
 std::string To_JSON (Node& Cur_Node, const int& Level, bool Print_Header=false, bool Indent=true);
 
@@ -37,6 +37,11 @@
         }
         using namespace WindowsNamespace;
     #endif
+#else //WINDOWS
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif //WINDOWS
 using namespace ZenLib;
 using namespace std;
@@ -54,6 +59,10 @@ using namespace std;
 namespace MediaInfoLib
 {
 
+//***************************************************************************
+// Read thread
+//***************************************************************************
+
 #if MEDIAINFO_READTHREAD
 void Reader_File_Thread::Entry()
 {
@@ -107,34 +116,39 @@ void Reader_File_Thread::Entry()
                 }
             }
             }
-            #ifdef WINDOWS
-                SetEvent(Base->Condition_WaitingForMoreData);
-            #endif //WINDOWS
+            Base->Condition_WaitingForMoreData->Signal();
         }
-        #ifdef WINDOWS
-            else
-                WaitForSingleObject(Base->Condition_WaitingForMorePlace, INFINITE);
-        #endif //WINDOWS
+        else
+            Base->Condition_WaitingForMorePlace->Wait();
 
         if (IsTerminating())
             break;
         Yield();
     }
 
-    #ifdef WINDOWS
-        SetEvent(Base->Condition_WaitingForMoreData); //Sending the last event in case the main threading is waiting for more data
-    #endif //WINDOWS
+    Base->Condition_WaitingForMoreData->Signal(); //Sending the last event in case the main threading is waiting for more data
 }
 #endif //MEDIAINFO_READTHREAD
 
 const size_t Buffer_NoJump=128*1024;
 
+//---------------------------------------------------------------------------
+Reader_File::Reader_File()
+{
+    Mmap_Buffer=NULL;
+    Mmap_Size=0;
+    #ifdef WINDOWS
+        Mmap_Handle=NULL;
+    #endif //WINDOWS
+}
+
 //---------------------------------------------------------------------------
 Reader_File::~Reader_File()
 {
     #if MEDIAINFO_READTHREAD
         Destroy_Thread(MI_Internal);
     #endif //MEDIAINFO_READTHREAD
+    Mmap_Close(NULL);
 }
 
 //---------------------------------------------------------------------------
@@ -144,13 +158,11 @@ void Reader_File::Destroy_Thread(MediaInfo_Internal* MI)
     if (ThreadInstance)
     {
         ThreadInstance->RequestTerminate();
-        SetEvent(Condition_WaitingForMorePlace);
+        Condition_WaitingForMorePlace->Signal();
         while (!ThreadInstance->IsExited())
-            Sleep(0);
-#ifdef WINDOWS
-        CloseHandle(Condition_WaitingForMorePlace);
-        CloseHandle(Condition_WaitingForMoreData);
-#endif //WINDOWS
+            Thread::Sleep(0);
+        delete Condition_WaitingForMorePlace; Condition_WaitingForMorePlace=NULL;
+        delete Condition_WaitingForMoreData; Condition_WaitingForMoreData=NULL;
         delete ThreadInstance; ThreadInstance = NULL;
 
         MI->Config.File_Buffer = NULL;
@@ -166,6 +178,80 @@ void Reader_File::Destroy_Thread(MediaInfo_Internal* MI)
 }
 #endif //MEDIAINFO_READTHREAD
 
+//---------------------------------------------------------------------------
+bool Reader_File::Mmap_Open(const String &File_Name)
+{
+    #ifdef WINDOWS
+        #ifdef UNICODE
+            HANDLE File_Handle=CreateFileW(File_Name.c_str(), GENERIC_READ, FILE_SHARE_READ|FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        #else //UNICODE
+            HANDLE File_Handle=CreateFileA(File_Name.c_str(), GENERIC_READ, FILE_SHARE_READ|FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        #endif //UNICODE
+        if (File_Handle==INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER File_Size;
+        if (!GetFileSizeEx(File_Handle, &File_Size) || !File_Size.QuadPart || (int64u)File_Size.QuadPart>(size_t)-1)
+        {
+            CloseHandle(File_Handle);
+            return false;
+        }
+        HANDLE Mapping=CreateFileMapping(File_Handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(File_Handle); //The mapping keeps its own reference
+        if (!Mapping)
+            return false;
+        void* Buffer=MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!Buffer)
+        {
+            CloseHandle(Mapping);
+            return false;
+        }
+        Mmap_Handle=Mapping;
+        Mmap_Size=File_Size.QuadPart;
+    #else //WINDOWS
+        int File_Handle=open(Ztring(File_Name).To_Local().c_str(), O_RDONLY);
+        if (File_Handle<0)
+            return false;
+        struct stat File_Stat;
+        if (fstat(File_Handle, &File_Stat) || !S_ISREG(File_Stat.st_mode) || !File_Stat.st_size || (int64u)File_Stat.st_size>(size_t)-1)
+        {
+            close(File_Handle);
+            return false;
+        }
+        void* Buffer=mmap(NULL, (size_t)File_Stat.st_size, PROT_READ, MAP_PRIVATE, File_Handle, 0);
+        close(File_Handle); //The mapping keeps its own reference
+        if (Buffer==MAP_FAILED)
+            return false;
+        posix_madvise(Buffer, (size_t)File_Stat.st_size, POSIX_MADV_SEQUENTIAL);
+        Mmap_Size=File_Stat.st_size;
+    #endif //WINDOWS
+
+    Mmap_Buffer=(int8u*)Buffer;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void Reader_File::Mmap_Close(MediaInfo_Internal* MI)
+{
+    if (!Mmap_Buffer)
+        return;
+
+    if (MI && MI->Config.File_Buffer>=Mmap_Buffer && MI->Config.File_Buffer<=Mmap_Buffer+Mmap_Size)
+    {
+        MI->Config.File_Buffer=NULL;
+        MI->Config.File_Buffer_Size=0;
+        MI->Config.File_Buffer_Size_Max=0;
+    }
+
+    #ifdef WINDOWS
+        UnmapViewOfFile(Mmap_Buffer);
+        CloseHandle(Mmap_Handle); Mmap_Handle=NULL;
+    #else //WINDOWS
+        munmap(Mmap_Buffer, (size_t)Mmap_Size);
+    #endif //WINDOWS
+    Mmap_Buffer=NULL;
+    Mmap_Size=0;
+}
+
 //---------------------------------------------------------------------------
 size_t Reader_File::Format_Test(MediaInfo_Internal* MI, String File_Name)
 {
@@ -246,6 +332,11 @@ size_t Reader_File::Format_Test_PerParser(MediaInfo_Internal* MI, const String &
     if (!F.Opened_Get())
         return 0;
 
+    //Memory mapping, the parser gets pointers in the mapping instead of a copy of the file content
+    Mmap_Close(MI);
+    if (MI->Config.File_Mmap_Get() && MI->Config.File_Names.size()<=1 && !MI->Config.File_GrowingFile_Force_Get())
+        Mmap_Open(File_Name);
+
     //Info
     Status=0;
     MI->Config.File_Size=F.Size_Get();
@@ -339,15 +430,13 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
             {
                 CS.Enter();
                 Buffer_Begin+=MI->Config.File_Buffer_Size;
-                #ifdef WINDOWS
-                    if (Buffer_Begin==Buffer_Max)
-                    {
-                        CS.Leave();
-                        SetEvent(Condition_WaitingForMorePlace);
-                    }
-                    else
-                #endif //WINDOWS
-                        CS.Leave();
+                if (Buffer_Begin==Buffer_Max)
+                {
+                    CS.Leave();
+                    Condition_WaitingForMorePlace->Signal();
+                }
+                else
+                    CS.Leave();
             }
         #endif //MEDIAINFO_READTHREAD
 
@@ -460,6 +549,8 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
 
                 if (GoTo>=F.Size_Get())
                     break; //Seek requested, but on a file bigger in theory than what is in the real file, we can't do this
+                if (Mmap_Buffer)
+                    Buffer_NoJump_Temp=0; //Jumps are only pointer moves
                 if (!(GoTo>F.Position_Get() && GoTo<F.Position_Get()+Buffer_NoJump_Temp)) //No smal jumps
                 {
                      if (!F.GoTo(GoTo))
@@ -482,10 +573,8 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                         Buffer_End=0;
                         Buffer_End2=0;
                         IsLooping=false;
-                        #ifdef WINDOWS
-                            Condition_WaitingForMorePlace=CreateEvent(NULL, FALSE, FALSE, NULL);
-                            Condition_WaitingForMoreData=CreateEvent(NULL, FALSE, FALSE, NULL);
-                        #endif //WINDOWS
+                        Condition_WaitingForMorePlace=new Condition;
+                        Condition_WaitingForMoreData=new Condition;
                         ThreadInstance=new Reader_File_Thread();
                         ThreadInstance->Base=this;
                         ThreadInstance->Run();
@@ -498,10 +587,13 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
             //Handling of hints
             if (MI->Config.File_Buffer_Size_ToRead==0)
                 break; //Problem while config
+            if (Mmap_Buffer && MI->Config.File_IsGrowing)
+                Mmap_Close(MI); //The mapping has the size of the file at opening time, back to normal reads
             if (
                 #if MEDIAINFO_READTHREAD
                     ThreadInstance==NULL &&
                 #endif //MEDIAINFO_READTHREAD
+                Mmap_Buffer==NULL &&
                 MI->Config.File_Buffer_Size_ToRead>MI->Config.File_Buffer_Size_Max)
             {
                 delete[] MI->Config.File_Buffer;
@@ -564,14 +656,12 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                 if (ThreadInstance)
                 {
                     CS.Enter();
-                    #ifdef WINDOWS
-                        if (Buffer_End2+Buffer_End-Buffer_Begin<Buffer_Max/8*7)
-                        {
-                            CS.Leave();
-                            SetEvent(Condition_WaitingForMorePlace);
-                            CS.Enter();
-                        }
-                    #endif //WINDOWS
+                    if (Buffer_End2+Buffer_End-Buffer_Begin<Buffer_Max/8*7)
+                    {
+                        CS.Leave();
+                        Condition_WaitingForMorePlace->Signal();
+                        CS.Enter();
+                    }
 
                     for (;;)
                     {
@@ -583,11 +673,7 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                         if (!ThreadInstance->IsExited())
                         {
                             CS.Leave();
-                            #ifdef WINDOWS
-                                WaitForSingleObject(Condition_WaitingForMoreData, INFINITE);
-                            #else //WINDOWS
-                                Sleep(0);
-                            #endif //WINDOWS
+                            Condition_WaitingForMoreData->Wait();
                             CS.Enter();
                         }
                         else
@@ -611,6 +697,17 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                 }
                 else
             #endif //MEDIAINFO_READTHREAD
+            if (Mmap_Buffer)
+            {
+                int64u Position=F.Position_Get();
+                int64u End=Partial_End<=MI->Config.File_Size?Partial_End:MI->Config.File_Size;
+                if (End>Mmap_Size)
+                    End=Mmap_Size;
+                MI->Config.File_Buffer=Mmap_Buffer+Position;
+                MI->Config.File_Buffer_Size=Position<End?((Position+MI->Config.File_Buffer_Size_ToRead<End)?MI->Config.File_Buffer_Size_ToRead:((size_t)(End-Position))):0;
+                F.GoTo(Position+MI->Config.File_Buffer_Size);
+            }
+            else
             {
                 MI->Config.File_Buffer_Size=F.Read(MI->Config.File_Buffer, (F.Position_Get()+MI->Config.File_Buffer_Size_ToRead<(Partial_End<=MI->Config.File_Size?Partial_End:MI->Config.File_Size))?MI->Config.File_Buffer_Size_ToRead:((size_t)((Partial_End<=MI->Config.File_Size?Partial_End:MI->Config.File_Size)-F.Position_Get())));
                 #if MEDIAINFO_READTHREAD
@@ -763,15 +860,13 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                 {
                     CS.Enter();
                     Buffer_Begin+=MI->Config.File_Buffer_Size;
-                    #ifdef WINDOWS
-                        if (Buffer_Begin==Buffer_Max)
-                        {
-                            CS.Leave();
-                            SetEvent(Condition_WaitingForMorePlace);
-                        }
-                        else
-                    #endif //WINDOWS
-                           CS.Leave();
+                    if (Buffer_Begin==Buffer_Max)
+                    {
+                        CS.Leave();
+                        Condition_WaitingForMorePlace->Signal();
+                    }
+                    else
+                        CS.Leave();
                 }
             #endif //MEDIAINFO_READTHREAD
 
@@ -802,6 +897,11 @@ size_t Reader_File::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
         }
         else
     #endif //MEDIAINFO_READTHREAD
+    if (Mmap_Buffer)
+    {
+        Mmap_Close(MI);
+    }
+    else
     {
         delete[] MI->Config.File_Buffer; MI->Config.File_Buffer=NULL;
         MI->Config.File_Buffer_Size_Max=0;
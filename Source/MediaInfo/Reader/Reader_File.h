@@ -23,18 +23,7 @@
 #include "ZenLib/Thread.h"
 #include "ZenLib/CriticalSection.h"
 #if MEDIAINFO_READTHREAD
-    #ifdef WINDOWS
-        #undef __TEXT
-        #if __cplusplus >= 201703L || _MSVC_LANG >= 201703L
-            namespace WindowsNamespace
-            {
-        #endif
-        #include "windows.h"
-        #if __cplusplus >= 201703L || _MSVC_LANG >= 201703L
-            }
-            using namespace WindowsNamespace;
-        #endif
-    #endif //WINDOWS
+    #include "MediaInfo/Condition.h"
 #endif //MEDIAINFO_READTHREAD
 //---------------------------------------------------------------------------
 
@@ -60,6 +49,7 @@ class Reader_File : public Reader__Base
 {
 public :
     //Constructor/Destructor
+    Reader_File();
     virtual ~Reader_File();
 
     //Format testing
@@ -83,16 +73,24 @@ public :
         size_t Buffer_End;
         size_t Buffer_End2; //Is also used for counting bytes before activating the thread
         bool   IsLooping;
-        #ifdef WINDOWS
-            HANDLE Condition_WaitingForMorePlace;
-            HANDLE Condition_WaitingForMoreData;
-        #endif //WINDOWS
+        Condition* Condition_WaitingForMorePlace;
+        Condition* Condition_WaitingForMoreData;
 private:
     void Destroy_Thread(MediaInfo_Internal* MI);
 public:
     #endif //MEDIAINFO_READTHREAD
     CriticalSection CS;
     MediaInfo_Internal* MI_Internal;
+
+    //Memory mapping
+    int8u*          Mmap_Buffer;
+    int64u          Mmap_Size;
+    #ifdef WINDOWS
+        void*       Mmap_Handle;
+    #endif //WINDOWS
+private:
+    bool Mmap_Open(const String &File_Name);
+    void Mmap_Close(MediaInfo_Internal* MI);
 };
 
 } //NameSpace
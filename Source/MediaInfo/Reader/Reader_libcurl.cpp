@@ -37,6 +37,7 @@
     #include "curl/curl.h"
 #endif
 #include <ctime>
+#include <list>
 #include <algorithm> //For Url
 #define MEDIAINFO_HMAC 1
 #if MEDIAINFO_HMAC
@@ -370,6 +371,19 @@ struct Reader_libcurl::curl_data
         bool            NextPacket;
     #endif //MEDIAINFO_NEXTPACKET
     time_t              Time_Max;
+    struct block
+    {
+        int64u          Offset;
+        std::string     Data;
+    };
+    std::list<block>    Blocks; //Most recently used first
+    size_t              Blocks_Max;
+    int64u              Range_Size;
+    int64u              Range_Begin;
+    int64u              Range_Offset;
+    bool                Range_Checked;
+    bool                Range_Seek;
+    std::string         Range_String;
     #ifdef MEDIAINFO_DEBUG
         int64u          Debug_BytesRead_Total;
         int64u          Debug_BytesRead;
@@ -396,6 +410,12 @@ struct Reader_libcurl::curl_data
             NextPacket=false;
         #endif //MEDIAINFO_NEXTPACKET
         Time_Max=0;
+        Blocks_Max=0;
+        Range_Size=0;
+        Range_Begin=(int64u)-1;
+        Range_Offset=(int64u)-1;
+        Range_Checked=false;
+        Range_Seek=false;
         #ifdef MEDIAINFO_DEBUG
             Debug_BytesRead_Total=0;
             Debug_BytesRead=0;
@@ -640,6 +660,111 @@ void Amazon_AWS_Manage(Http::Url &File_URL, Reader_libcurl::curl_data* Curl_Data
     }
 }
 
+//---------------------------------------------------------------------------
+bool libcurl_Buffer_Continue(Reader_libcurl::curl_data* Data, const int8u* Buffer, size_t Buffer_Size)
+{
+    #if MEDIAINFO_EVENTS
+        if (Buffer_Size)
+        {
+            struct MediaInfo_Event_Global_BytesRead_0 Event;
+            memset(&Event, 0xFF, sizeof(struct MediaInfo_Event_Generic));
+            Event.EventCode=MediaInfo_EventCode_Create(MediaInfo_Parser_None, MediaInfo_Event_Global_BytesRead, 0);
+            Event.EventSize=sizeof(struct MediaInfo_Event_Global_BytesRead_0);
+            Event.StreamIDs_Size=0;
+            Event.StreamOffset=Data->FileOffset;
+            Event.Content_Size=Buffer_Size;
+            Event.Content=(int8u*)Buffer;
+            Data->MI->Config.Event_Send(NULL, (const int8u*)&Event, sizeof(MediaInfo_Event_Global_BytesRead_0));
+            Data->FileOffset+=Buffer_Size;
+            if (Data->FileOffset>Data->FileSize)
+            {
+                Data->MI->Config.File_IsGrowing=true;
+                Data->FileOffset=Data->FileSize;
+            }
+        }
+    #endif //MEDIAINFO_EVENTS
+
+    //Continue
+    Data->Status=Data->MI->Open_Buffer_Continue(Buffer, Buffer_Size);
+    if (Data->Status[File__Analyze::IsFinished] || (Data->Time_Max && time(0)>=Data->Time_Max))
+        return false;
+
+    //GoTo
+    if (Data->MI->Open_Buffer_Continue_GoTo_Get()!=(int64u)-1)
+        return false;
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+size_t libcurl_WriteData_CallBack_Range(char* ptr, size_t Size, Reader_libcurl::curl_data* Data)
+{
+    //Server must honour the range
+    if (!Data->Range_Checked)
+    {
+        long http_code=0;
+        if (curl_easy_getinfo(Data->Curl, CURLINFO_RESPONSE_CODE, &http_code)!=CURLE_OK || http_code!=206)
+        {
+            Data->Range_Size=0; //Back to open ended requests
+            return 0;
+        }
+        Data->Range_Checked=true;
+        Data->Blocks.push_front(Reader_libcurl::curl_data::block());
+        Data->Blocks.front().Offset=Data->Range_Begin;
+        if (Data->Blocks.size()>Data->Blocks_Max)
+            Data->Blocks.pop_back();
+    }
+
+    //Caching what is received, the transfer is aborted on seek
+    std::string &Block=Data->Blocks.front().Data;
+    int64u Block_End=Data->Range_Begin+Block.size();
+    Block.append(ptr, Size);
+    if (Block_End+Size<=Data->Range_Offset)
+        return Size; //Prefetch of the tail, before the requested offset
+    size_t Skip=(size_t)(Block_End<Data->Range_Offset?Data->Range_Offset-Block_End:0);
+
+    //Continue
+    Data->Range_Offset+=Size-Skip;
+    if (!libcurl_Buffer_Continue(Data, (int8u*)ptr+Skip, Size-Skip))
+        return 0;
+
+    return Size;
+}
+
+//---------------------------------------------------------------------------
+bool libcurl_Cache_Read(Reader_libcurl::curl_data* Data)
+{
+    for (std::list<Reader_libcurl::curl_data::block>::iterator Block=Data->Blocks.begin(); Block!=Data->Blocks.end(); ++Block)
+        if (Block->Offset<=Data->Range_Offset && Data->Range_Offset<Block->Offset+Block->Data.size())
+        {
+            Data->Blocks.splice(Data->Blocks.begin(), Data->Blocks, Block);
+            size_t Skip=(size_t)(Data->Range_Offset-Block->Offset);
+            Data->Range_Offset=Block->Offset+Block->Data.size();
+            Data->Range_Seek=false; //Seek is served, sequential read continues with the cache or an open ended request
+            libcurl_Buffer_Continue(Data, (const int8u*)Block->Data.data()+Skip, Block->Data.size()-Skip);
+            return true;
+        }
+    return false;
+}
+
+//---------------------------------------------------------------------------
+void libcurl_Range_Set(Reader_libcurl::curl_data* Data)
+{
+    int64u Begin=Data->Range_Offset;
+    int64u End=Begin+Data->Range_Size;
+    if (Data->FileSize!=(int64u)-1 && End>=Data->FileSize)
+    {
+        //Footers and indexes are often read backwards from the end, prefetching the whole tail
+        Begin=Data->FileSize>Data->Range_Size?(Data->FileSize-Data->Range_Size):0;
+        End=Data->FileSize;
+    }
+    Data->Range_Begin=Begin;
+    Data->Range_Checked=false;
+    Data->Range_String=Ztring::ToZtring(Begin).To_UTF8()+'-'+Ztring::ToZtring(End-1).To_UTF8();
+    curl_easy_setopt(Data->Curl, CURLOPT_RESUME_FROM, 0L); //Open ended offset of a previous request
+    curl_easy_setopt(Data->Curl, CURLOPT_RANGE, Data->Range_String.c_str());
+}
+
 //---------------------------------------------------------------------------
 size_t libcurl_WriteData_CallBack(void *ptr, size_t size, size_t nmemb, void *data)
 {
@@ -704,41 +829,12 @@ size_t libcurl_WriteData_CallBack(void *ptr, size_t size, size_t nmemb, void *da
         ((Reader_libcurl::curl_data*)data)->Init_AlreadyDone=true;
     }
 
-    #if MEDIAINFO_EVENTS
-        if (size*nmemb)
-        {
-            struct MediaInfo_Event_Global_BytesRead_0 Event;
-            memset(&Event, 0xFF, sizeof(struct MediaInfo_Event_Generic));
-            Event.EventCode=MediaInfo_EventCode_Create(MediaInfo_Parser_None, MediaInfo_Event_Global_BytesRead, 0);
-            Event.EventSize=sizeof(struct MediaInfo_Event_Global_BytesRead_0);
-            Event.StreamIDs_Size=0;
-            Event.StreamOffset=((Reader_libcurl::curl_data*)data)->FileOffset;
-            Event.Content_Size=size*nmemb;
-            Event.Content=(int8u*)ptr;
-            ((Reader_libcurl::curl_data*)data)->MI->Config.Event_Send(NULL, (const int8u*)&Event, sizeof(MediaInfo_Event_Global_BytesRead_0));
-            ((Reader_libcurl::curl_data*)data)->FileOffset+=size*nmemb;
-            if (((Reader_libcurl::curl_data*)data)->FileOffset>((Reader_libcurl::curl_data*)data)->FileSize)
-            {
-                ((Reader_libcurl::curl_data*)data)->MI->Config.File_IsGrowing=true;
-                ((Reader_libcurl::curl_data*)data)->FileOffset=((Reader_libcurl::curl_data*)data)->FileSize;
-            }
-        }
-    #endif //MEDIAINFO_EVENTS
-
-    //Continue
-    ((Reader_libcurl::curl_data*)data)->Status=((Reader_libcurl::curl_data*)data)->MI->Open_Buffer_Continue((int8u*)ptr, size*nmemb);
-    time_t CurrentTime = time(0);
+    //Range request
+    if (((Reader_libcurl::curl_data*)data)->Range_Begin!=(int64u)-1)
+        return libcurl_WriteData_CallBack_Range((char*)ptr, size*nmemb, (Reader_libcurl::curl_data*)data);
 
-    if (((Reader_libcurl::curl_data*)data)->Status[File__Analyze::IsFinished] || (((Reader_libcurl::curl_data*)data)->Time_Max && CurrentTime>=((Reader_libcurl::curl_data*)data)->Time_Max))
-    {
+    if (!libcurl_Buffer_Continue((Reader_libcurl::curl_data*)data, (int8u*)ptr, size*nmemb))
         return 0;
-    }
-
-    //GoTo
-    if (((Reader_libcurl::curl_data*)data)->MI->Open_Buffer_Continue_GoTo_Get()!=(int64u)-1)
-    {
-        return 0;
-    }
 
     //Continue parsing
     return size*nmemb;
@@ -1142,6 +1238,21 @@ size_t Reader_libcurl::Format_Test_PerParser(MediaInfo_Internal* MI, const Strin
     curl_easy_setopt(Curl_Data->Curl, CURLOPT_ERRORBUFFER, Curl_Data->ErrorBuffer);
     curl_easy_setopt(Curl_Data->Curl, CURLOPT_HTTPHEADER, Curl_Data->HttpHeader);
 
+    //Range requests and block cache for seeks, "File_Curl;RangeSize;0" disables them
+    if ((File_URL.Protocol=="http" || File_URL.Protocol=="https") && !MI->Config.File_GrowingFile_Force_Get())
+    {
+        Ztring RangeSize=MI->Config.File_Curl_Get(__T("RangeSize"));
+        Ztring RangeCache=MI->Config.File_Curl_Get(__T("RangeCache"));
+        Curl_Data->Range_Size=RangeSize.empty()?0x100000:RangeSize.To_int64u(); //1 MiB by default
+        Curl_Data->Blocks_Max=RangeCache.empty()?8:RangeCache.To_int32u();
+        if (!Curl_Data->Blocks_Max)
+            Curl_Data->Blocks_Max=1; //At least the current range
+        #if MEDIAINFO_NEXTPACKET
+            if (Curl_Data->NextPacket)
+                Curl_Data->Range_Size=0;
+        #endif //MEDIAINFO_NEXTPACKET
+    }
+
     //Test the format with buffer
     return Format_Test_PerParser_Continue(MI);
 }
@@ -1186,34 +1297,80 @@ size_t Reader_libcurl::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                     Curl_Data->Debug_BytesRead=0;
                     Curl_Data->Debug_Count++;
                 #endif //MEDIAINFO_DEBUG
-                CURLcode Code;
-                CURL* Temp=curl_easy_duphandle(Curl_Data->Curl);
-                if (Temp==0)
-                    return 0;
-                #if MEDIAINFO_NEXTPACKET
-                    if (Curl_Data->CurlM)
-                            curl_multi_remove_handle(Curl_Data->CurlM, Curl_Data->Curl);
-                #endif //MEDIAINFO_NEXTPACKET
-                curl_easy_cleanup(Curl_Data->Curl); Curl_Data->Curl=Temp;
-                #if MEDIAINFO_NEXTPACKET
-                    if (Curl_Data->CurlM)
-                            curl_multi_add_handle(Curl_Data->CurlM, Curl_Data->Curl);
-                #endif //MEDIAINFO_NEXTPACKET
-                if (Curl_Data->MI->Open_Buffer_Continue_GoTo_Get()<0x80000000)
+                if (Curl_Data->Range_Size && Curl_Data->Init_AlreadyDone)
                 {
-                    //We do NOT use large version if we can, because some version (tested: 7.15 linux) do NOT like large version (error code 18)
-                    long File_GoTo_Long=(long)Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
-                    Code=curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM, File_GoTo_Long);
+                    //Bounded range request at the seek target, the same handle keeps the connection alive
+                    Curl_Data->Range_Offset=Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
+                    Curl_Data->Range_Seek=true;
+                    Curl_Data->FileOffset=Curl_Data->Range_Offset;
+                    MI->Open_Buffer_Init((int64u)-1, Curl_Data->Range_Offset);
                 }
                 else
                 {
-                    curl_off_t File_GoTo_Off=(curl_off_t)Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
-                    Code=curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM_LARGE, File_GoTo_Off);
+                    CURLcode Code;
+                    CURL* Temp=curl_easy_duphandle(Curl_Data->Curl);
+                    if (Temp==0)
+                        return 0;
+                    #if MEDIAINFO_NEXTPACKET
+                        if (Curl_Data->CurlM)
+                                curl_multi_remove_handle(Curl_Data->CurlM, Curl_Data->Curl);
+                    #endif //MEDIAINFO_NEXTPACKET
+                    curl_easy_cleanup(Curl_Data->Curl); Curl_Data->Curl=Temp;
+                    #if MEDIAINFO_NEXTPACKET
+                        if (Curl_Data->CurlM)
+                                curl_multi_add_handle(Curl_Data->CurlM, Curl_Data->Curl);
+                    #endif //MEDIAINFO_NEXTPACKET
+                    if (Curl_Data->MI->Open_Buffer_Continue_GoTo_Get()<0x80000000)
+                    {
+                        //We do NOT use large version if we can, because some version (tested: 7.15 linux) do NOT like large version (error code 18)
+                        long File_GoTo_Long=(long)Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
+                        Code=curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM, File_GoTo_Long);
+                    }
+                    else
+                    {
+                        curl_off_t File_GoTo_Off=(curl_off_t)Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
+                        Code=curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM_LARGE, File_GoTo_Off);
+                    }
+                    if (Code==CURLE_OK)
+                    {
+                        Curl_Data->FileOffset=Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
+                        MI->Open_Buffer_Init((int64u)-1, Curl_Data->MI->Open_Buffer_Continue_GoTo_Get());
+                    }
+                }
+            }
+
+            //Range requests
+            if (Curl_Data->Range_Size && Curl_Data->Init_AlreadyDone && Curl_Data->Range_Offset!=(int64u)-1)
+            {
+                if (Curl_Data->Range_Offset>=Curl_Data->FileSize || (Curl_Data->Time_Max && time(0)>=Curl_Data->Time_Max))
+                    break; //Nothing more is requested by the parser
+                if (libcurl_Cache_Read(Curl_Data))
+                {
+                    #if MEDIAINFO_DEMUX
+                        if (MI->Config.Demux_EventWasSent)
+                            return 2; //Must return immediately
+                    #endif //MEDIAINFO_DEMUX
+                    continue;
                 }
-                if (Code==CURLE_OK)
+                if (Curl_Data->Range_Seek)
                 {
-                    Curl_Data->FileOffset=Curl_Data->MI->Open_Buffer_Continue_GoTo_Get();
-                    MI->Open_Buffer_Init((int64u)-1, Curl_Data->MI->Open_Buffer_Continue_GoTo_Get());
+                    Curl_Data->Range_Seek=false;
+                    libcurl_Range_Set(Curl_Data);
+                }
+                else
+                {
+                    //Sequential read after the range, open ended request
+                    if (Curl_Data->Range_Offset<0x80000000)
+                    {
+                        long Range_Offset_Long=(long)Curl_Data->Range_Offset;
+                        curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM, Range_Offset_Long);
+                    }
+                    else
+                    {
+                        curl_off_t Range_Offset_Off=(curl_off_t)Curl_Data->Range_Offset;
+                        curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM_LARGE, Range_Offset_Off);
+                    }
+                    Curl_Data->Range_Offset=(int64u)-1;
                 }
             }
 
@@ -1336,6 +1493,28 @@ size_t Reader_libcurl::Format_Test_PerParser_Continue (MediaInfo_Internal* MI)
                     curl_easy_setopt(Curl_Data->Curl, CURLOPT_URL, FileName_String.c_str());
                     Result=curl_easy_perform(Curl_Data->Curl);
                 }
+                if (Curl_Data->Range_Begin!=(int64u)-1)
+                {
+                    Curl_Data->Range_Begin=(int64u)-1;
+                    curl_easy_setopt(Curl_Data->Curl, CURLOPT_RANGE, NULL);
+                    if (!Curl_Data->Range_Size)
+                    {
+                        //Range not supported by the server, open ended request from the same offset
+                        if (Curl_Data->Range_Offset<0x80000000)
+                        {
+                            long Range_Offset_Long=(long)Curl_Data->Range_Offset;
+                            curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM, Range_Offset_Long);
+                        }
+                        else
+                        {
+                            curl_off_t Range_Offset_Off=(curl_off_t)Curl_Data->Range_Offset;
+                            curl_easy_setopt(Curl_Data->Curl, CURLOPT_RESUME_FROM_LARGE, Range_Offset_Off);
+                        }
+                        Result=CURLE_WRITE_ERROR;
+                    }
+                    else if (Result==CURLE_OK)
+                        Result=CURLE_WRITE_ERROR; //Sequential read, seek or end of file is handled by the loop
+                }
                 if ((MI->Config.File_IsGrowing                                                                          //Was previously detected as growing
                   || (!MI->Config.File_IsNotGrowingAnymore && MI->Config.File_GrowingFile_Force_Get())))                //Forced test and container did not indicate it is not growing anymore
                 {
@@ -342,7 +342,7 @@
     #if !defined(MEDIAINFO_READTHREAD_NO) && !defined(MEDIAINFO_READTHREAD_YES)
         #define MEDIAINFO_READTHREAD_NO //MEDIAINFO_READTHREAD_NO by default, as there are
     #endif
-    #if defined(MEDIAINFO_READTHREAD_NO) || !defined(WINDOWS) //Currently supported only on Windows TODO: add support of non Windows OS
+    #if defined(MEDIAINFO_READTHREAD_NO) //Supported on Windows (events) and POSIX (pthread conditions)
         #define MEDIAINFO_READTHREAD 0
     #else
         #define MEDIAINFO_READTHREAD 1
@@ -1811,18 +1811,8 @@ void File_Avc::Data_Parse()
     int64u Save_File_Offset=File_Offset;
     size_t Save_Buffer_Offset=Buffer_Offset;
     int64u Save_Element_Size=Element_Size;
-    size_t Element_Offset_3Bytes=(size_t)Element_Offset;
     std::vector<size_t> ThreeByte_List;
-    while (Element_Offset_3Bytes+3<=Element_Size)
-    {
-        if (CC3(Buffer+Buffer_Offset+(size_t)Element_Offset_3Bytes)==0x000003)
-            ThreeByte_List.push_back(Element_Offset_3Bytes+2);
-        Element_Offset_3Bytes+=2;
-        while(Element_Offset_3Bytes<Element_Size && Buffer[Buffer_Offset+(size_t)Element_Offset_3Bytes]!=0x00)
-            Element_Offset_3Bytes+=2;
-        if (Element_Offset_3Bytes>=Element_Size || Buffer[Buffer_Offset+(size_t)Element_Offset_3Bytes-1]==0x00)
-            Element_Offset_3Bytes--;
-    }
+    Emulation_Prevention_Find((size_t)Element_Offset, (size_t)Element_Size, ThreeByte_List);
 
     if (!ThreeByte_List.empty())
     {